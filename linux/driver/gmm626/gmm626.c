@@ -49,7 +49,7 @@ struct gmm626_data {
 	u16 mode;
 	u16 max_mode;
 
-	struct notifier_block mode_nb;
+	struct gsv2k11_async_nb mode_anb;
 };
 
 struct payload_id {
@@ -198,7 +198,7 @@ static void gmm626_set_mode(struct spi_device *spi, u16 mode)
 static int gmm626_mode_notifier(struct notifier_block *nb,
 			     unsigned long event, void *data)
 {
-	struct gmm626_data *gmm626 = container_of(nb, struct gmm626_data, mode_nb);
+	struct gmm626_data *gmm626 = container_of(nb, struct gmm626_data, mode_anb.nb);
 	u16 mode = payloadID_default;
 
 	if (event) {
@@ -541,8 +541,8 @@ static int gmm626_driver_probe(struct spi_device *spi)
 	gmm626_reset(spi);
 	gmm626_set_rate_status(spi, gmm626->rate0, gmm626->rate1);
 
-	gmm626->mode_nb.notifier_call = gmm626_mode_notifier;
-	gsv2k11_notifier_register(&gmm626->mode_nb);
+	gmm626->mode_anb.nb.notifier_call = gmm626_mode_notifier;
+	gsv2k11_notifier_register_async(&gmm626->mode_anb);
 
 	dev_info(dev, "gmm626 probe success\n");
 
@@ -553,7 +553,7 @@ static int gmm626_driver_remove(struct spi_device *spi)
 {
 	struct gmm626_data *gmm626 = spi_get_drvdata(spi);
 
-	gsv2k11_notifier_unregister(&gmm626->mode_nb);
+	gsv2k11_notifier_unregister_async(&gmm626->mode_anb);
 
 	devm_device_remove_group(&spi->dev, &gmm626_attribute_group);
 
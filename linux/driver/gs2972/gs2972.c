@@ -54,7 +54,7 @@ struct gs2972_data {
 	u16 mode;
 	u16 max_mode;
 
-	struct notifier_block mode_nb;
+	struct gsv2k11_async_nb mode_anb;
 };
 
 struct payload_id {
@@ -208,7 +208,7 @@ static void gs2972_set_mode(struct spi_device *spi, u16 mode)
 static int gs2972_mode_notifier(struct notifier_block *nb,
 			     unsigned long event, void *data)
 {
-	struct gs2972_data *gs2972 = container_of(nb, struct gs2972_data, mode_nb);
+	struct gs2972_data *gs2972 = container_of(nb, struct gs2972_data, mode_anb.nb);
 	u16 mode = payloadID_default;
 
 	if (event) {
@@ -544,8 +544,8 @@ static int gs2972_driver_probe(struct spi_device *spi)
 	gs2972_reset(spi);
 	gs2972_set_rate_status(spi, gs2972->rate0, gs2972->rate1);
 
-	gs2972->mode_nb.notifier_call = gs2972_mode_notifier;
-	gsv2k11_notifier_register(&gs2972->mode_nb);
+	gs2972->mode_anb.nb.notifier_call = gs2972_mode_notifier;
+	gsv2k11_notifier_register_async(&gs2972->mode_anb);
 
 	dev_info(dev, "gs2972 probe success\n");
 
@@ -556,7 +556,7 @@ static int gs2972_driver_remove(struct spi_device *spi)
 {
 	struct gs2972_data *gs2972 = spi_get_drvdata(spi);
 
-	gsv2k11_notifier_unregister(&gs2972->mode_nb);
+	gsv2k11_notifier_unregister_async(&gs2972->mode_anb);
 
 	devm_device_remove_group(&spi->dev, &gs2972_attribute_group);
 
@@ -4,7 +4,6 @@
 uchar  DevicePowerStatus = 0;
 char   DeviceName[20] = "GSV Default";
 uchar  AudioStatus = 0;
-CEC_AUDIO_STATUS Cec_Tx_Audio_Status;
 #endif
 
 const uint8 PktSize[20] ={31, /*AV_PKT_AV_INFO_FRAME */
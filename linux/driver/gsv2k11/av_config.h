@@ -31,7 +31,7 @@ typedef int            int32;
 
 #include "av_user_config_input.h"
 
-/* total static buffer, for internal use */
+/* static buffer of each device, for internal use */
 #define AvGlobalStaticBufferSize Gsv2kResourceSize * 2
 
 /* ----------------------------- seperate line ------------------------------
@@ -205,6 +205,11 @@ typedef struct
     void *specific;                  /**< device specific config */
     void *port;                      /**< device first port      */
     void *extension;                 /**< device extension       */
+    void *context;                   /**< bsp context for i2c    */
+    uint8 *buffer;                   /**< port content buffer    */
+    uint32 bufferUsed;               /**< bytes used in buffer   */
+    void *edid;                      /**< edid manage workspace  */
+    uint32 generation;               /**< bumped on any port change */
 } AvDevice;
 
 /* Layer 5 */
@@ -282,6 +287,20 @@ typedef enum{
 #define AV_BIT_FEAT_10B_DEEP_COLOR      (1<<27)
 #define AV_BIT_FEAT_COMPRESS_AUDIO      (1<<28)
 
+/* interrupt events decoded from the interrupt map */
+#define AV_BIT_INT_RX_LOCK              (1<<0)
+#define AV_BIT_INT_RX_VIDEO             (1<<1)
+#define AV_BIT_INT_RX_AUDIO             (1<<2)
+#define AV_BIT_INT_RX_HDCP              (1<<3)
+#define AV_BIT_INT_TX_HPD               (1<<4)
+#define AV_BIT_INT_TX_CEC               (1<<5)
+#define AV_BIT_INT_ALL                  0x3F
+
+/* cec transmit results */
+#define AV_BIT_CEC_TX_READY             (1<<0)
+#define AV_BIT_CEC_TX_ARB_LOST          (1<<1)
+#define AV_BIT_CEC_TX_TIMEOUT           (1<<2)
+
 #define AV_BCAPS_RECEIVER_MODE          0x80
 #define AV_BCAPS_REPEATER_MODE          0xC0
 #define AV_BSTATUS_RECEIVER_MODE        0x0000
@@ -909,6 +928,7 @@ typedef struct {
     uint8       Input5V;
     AvHpdState  Hpd;
     uint8       HpdDelayExpire;
+    uint32      HpdLowStart;      /**< when hpd was last pulled low, in ms */
     AvLock      Lock;
     uint16      ChangedVideoPackets;
     uint16      ChangedAudioPackets;
@@ -923,18 +943,31 @@ typedef struct {
     /* Part 3, Connect Status*/
     AvLock      Lock;
     uint8       InfoReady;
+    uint32      InfoReadyStart;   /**< first InfoReady step after a reset, in ms */
     /* Part 4, Edid */
     uint8       EdidReadFail;
     EdidStat    EdidReadSuccess;
     uint8       IgnoreEdidError;
     uint8       EdidCks[2];
     uint16      PhyAddr;
+    uint8       EdidWaiting;      /**< a read is waiting for EDID ready */
+    uint32      EdidWaitStart;    /**< start of that wait, in ms */
+    uint16      EdidWaitMs;       /**< last wait for EDID ready on read, in ms */
+    uint16      EdidWaitMaxMs;    /**< longest wait for EDID ready, in ms */
+    uint16      EdidWaitTimeouts; /**< waits that gave up after AvEdidReadyTimeout */
+    uint16      EdidCacheHits;    /**< reads served from the sink edid copy */
     uint32      EdidSupportFeature;
     /* Part 5, Protocol */
     AvHpdState  Hpd;
     uint8       HpdDelayExpire;
     uint16      ChangedVideoPackets;
     uint16      ChangedAudioPackets;
+#if AvEnableTxPacketCks
+    /* Part 6, Forwarded Packets */
+    uint32      PktSign[AV_PKT_ALL_PACKETS];
+    uint32      PktForwarded;
+    uint32      PktSuppressed;
+#endif
 } TxVars;
 
 typedef struct {
@@ -1027,6 +1060,8 @@ typedef struct {
     uint8       EnableARC;
     uint8       EnableAudioAmplifier;
     uint8       ARCTryCount;
+    /* Part 6, Audio System */
+    CEC_AUDIO_STATUS AudioState;
 } AvCec;
 #endif
 
@@ -1332,6 +1367,11 @@ typedef struct
     AvContent content;     /**< port content */
     AvHwCore core;         /**< hardware cores that port is using, for internal use */
     struct AvPort *next;   /**< next port, internally assigned when created */
+    uint32 generation;     /**< device generation the port was last updated at */
+    uint32 signature;      /**< port content signature at the last update */
+    uint32 serviced;       /**< number of port updates */
+    uint32 skipped;        /**< number of port updates skipped as clean */
+    uint8  resume;         /**< plug fsm state saved at suspend if stable, else 0 */
 } AvPort;
 
 #endif
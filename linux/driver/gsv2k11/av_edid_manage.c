@@ -6,7 +6,7 @@ static const uint8  AvEdidSupportDpm   =
                      AvEdidBitDpmStandby |
                      AvEdidBitDpmSuspend |
                      AvEdidBitDpmActiveOff;
-uint16 AvEdidSupportFreq  =
+static const uint16 AvEdidDefaultSupportFreq  =
                      AvEdidBitFreq6G    |
                      AvEdidBitFreq4P5G  |
                      AvEdidBitFreq3P75G |
@@ -137,12 +137,13 @@ static const uint8  AvEdidSpeaker5p1Ch         =  0x0F;
 static const uint8  AvEdidSpeaker7p1Ch         =  0x5F;
 /* EDID Capability Declare End */
 /* EDID Param Declare Start */
-uint16 AvEdidVesaParamForce =  0;
-uint8 AvEdidCeaParamForce  =  0;//AvEdidBitCeaSVD | AvEdidBitCeaVSDBHF;
-uint16 AvEdidCeabParamForce = 0;//AvEdidBitCeabCDB | AvEdidBitCeabVCDB;
-uint16 AvEdidVesaParamRemove = 0;
-uint8 AvEdidCeaParamRemove  = 0;
-uint16 AvEdidCeabParamRemove = 0;
+/* defaults loaded into AvEdidReg by AvEdidFuncParamInit, the merge only reads the per device copy */
+static const uint16 AvEdidDefaultVesaParamForce  = 0;
+static const uint8  AvEdidDefaultCeaParamForce   = 0;//AvEdidBitCeaSVD | AvEdidBitCeaVSDBHF;
+static const uint16 AvEdidDefaultCeabParamForce  = 0;//AvEdidBitCeabCDB | AvEdidBitCeabVCDB;
+static const uint16 AvEdidDefaultVesaParamRemove = 0;
+static const uint8  AvEdidDefaultCeaParamRemove  = 0;
+static const uint16 AvEdidDefaultCeabParamRemove = 0;
 /* EDID Param Declare End */
 /* EDID Table Declare Start */
 static const uint8 AvEdidIDManufacturerName[] =  {'G','S','V'};
@@ -167,7 +168,6 @@ static const uint8 EdidAudioFormatCode[] =  {1<<3,2<<3,3<<3,4<<3,5<<3,6<<3,7<<3,
 static const uint8 EdidCeaVicList[] =  {97,96,101,102,98,99,100,93,94,95,16,31,4,19,5,20,32,33,34,3,18,7,22};
 /* EDID Table Declare End */
 /* EDID Structure Init Start */
-AvEdidReg DevEdidReg;
 void AvEdidFuncStructInit(AvEdidReg *EdidReg)
 {
     uint8 i = 0;
@@ -206,6 +206,83 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
     return;
 }
 /* EDID Structure Init End */
+/* EDID Param Init Start */
+void AvEdidFuncParamInit(AvEdidReg *EdidReg)
+{
+    EdidReg->SupportFreq     = AvEdidDefaultSupportFreq;
+    EdidReg->VesaParamForce  = AvEdidDefaultVesaParamForce;
+    EdidReg->CeaParamForce   = AvEdidDefaultCeaParamForce;
+    EdidReg->CeabParamForce  = AvEdidDefaultCeabParamForce;
+    EdidReg->VesaParamRemove = AvEdidDefaultVesaParamRemove;
+    EdidReg->CeaParamRemove  = AvEdidDefaultCeaParamRemove;
+    EdidReg->CeabParamRemove = AvEdidDefaultCeabParamRemove;
+    return;
+}
+/* EDID Param Init End */
+/* EDID Merge Start */
+/* merge SinkEdid into InEdid, pure byte array work so it also builds outside the driver */
+void AvEdidFuncMerge(AvEdidReg *EdidReg,uint8 *InEdid,uint8 *SinkEdid,uint8 *OutEdid)
+{
+    AvEdidFuncStructInit(EdidReg);
+    AvEdidFuncVesaProcess(EdidReg,InEdid,SinkEdid,OutEdid);
+    AvEdidFuncCeaProcess(EdidReg,InEdid,SinkEdid,OutEdid);
+    return;
+}
+/* EDID Merge End */
+/* EDID Cache Start */
+#if AvEdidCacheEntries
+/* FNV-1a, chained over every merge input */
+uint32 AvEdidFuncFingerprint(uint32 Hash,uint8 *Data,uint16 Length)
+{
+    uint16 i = 0;
+    if(Hash == 0)
+        Hash = 0x811c9dc5;
+    for(i=0;i<Length;i++)
+    {
+        Hash = Hash ^ Data[i];
+        Hash = Hash * 0x01000193;
+    }
+    /* 0 marks a free entry */
+    if(Hash == 0)
+        Hash = 1;
+    return Hash;
+}
+
+AvEdidCacheEntry *AvEdidFuncCacheLookup(AvEdidWorkspace *Edid,uint32 Key)
+{
+    uint8 i = 0;
+    for(i=0;i<AvEdidCacheEntries;i++)
+    {
+        if(Edid->Cache[i].Key == Key)
+            return &Edid->Cache[i];
+    }
+    return NULL;
+}
+
+void AvEdidFuncCacheStore(AvEdidWorkspace *Edid,uint32 Key,uint8 *OutEdid,uint8 SpaLocation,uint8 *SpaValue)
+{
+    AvEdidCacheEntry *Entry = &Edid->Cache[Edid->CacheNext];
+    uint16 i = 0;
+    Edid->CacheNext = (Edid->CacheNext + 1) % AvEdidCacheEntries;
+    Entry->Key = Key;
+    Entry->SpaLocation = SpaLocation;
+    Entry->SpaValue[0] = SpaValue[0];
+    Entry->SpaValue[1] = SpaValue[1];
+    for(i=0;i<256;i++)
+        Entry->OutEdid[i] = OutEdid[i];
+    return;
+}
+
+/* rx edid rams lost their content, e.g. chip reset or power loss */
+void AvEdidFuncCacheRamLost(AvEdidWorkspace *Edid)
+{
+    uint8 i = 0;
+    for(i=0;i<4;i++)
+        Edid->RxRamKey[i] = 0;
+    return;
+}
+#endif
+/* EDID Cache End */
 /* EDID Function Declare Start */
     void AvEdidFuncBulkAddValue(uint8 *table,uint8 total,uint8 start,uint8 value)
     {
@@ -385,8 +462,8 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         {
             OutEdid[i+18] = EdidVesaVersion[i];
         }
-        if((AvEdidVesaParamForce  & AvEdidBitVesaVideoInputDEF) ||
-           (AvEdidVesaParamRemove & AvEdidBitVesaVideoInputDEF))
+        if((EdidReg->VesaParamForce  & AvEdidBitVesaVideoInputDEF) ||
+           (EdidReg->VesaParamRemove & AvEdidBitVesaVideoInputDEF))
         {
             OutEdid[20] = 0x80;
         }
@@ -412,8 +489,8 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                 OutEdid[20] = 0x80;
             }
         }
-        if((AvEdidVesaParamForce  & AvEdidBitVesaScreenSIZE) ||
-           (AvEdidVesaParamRemove & AvEdidBitVesaScreenSIZE))
+        if((EdidReg->VesaParamForce  & AvEdidBitVesaScreenSIZE) ||
+           (EdidReg->VesaParamRemove & AvEdidBitVesaScreenSIZE))
         {
             OutEdid[21] = AvEdidScreenHSize;
             OutEdid[22] = AvEdidScreenVSize;
@@ -444,8 +521,8 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                 OutEdid[22] = AvEdidScreenVSize;
             }
         }
-        if((AvEdidVesaParamForce  & AvEdidBitVesaGAMMA) ||
-           (AvEdidVesaParamRemove & AvEdidBitVesaGAMMA))
+        if((EdidReg->VesaParamForce  & AvEdidBitVesaGAMMA) ||
+           (EdidReg->VesaParamRemove & AvEdidBitVesaGAMMA))
         {
             OutEdid[23] = 0x78;
         }
@@ -471,7 +548,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                 OutEdid[23] = 0x78;
             }
         }
-        if(AvEdidVesaParamForce  & AvEdidBitVesaDPM)
+        if(EdidReg->VesaParamForce  & AvEdidBitVesaDPM)
         {
             OutEdid[24] = 0x02;
             if(AvEdidSupportDpm & AvEdidBitDpmStandby)
@@ -506,7 +583,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                 OutEdid[24] = OutEdid[24] | (0x01<<3);
             }
         }
-        else if(AvEdidVesaParamRemove & AvEdidBitVesaDPM)
+        else if(EdidReg->VesaParamRemove & AvEdidBitVesaDPM)
         {
             OutEdid[24] = 0x0a;
         }
@@ -525,8 +602,8 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                 OutEdid[24] = 0x0a;
             }
         }
-        if((AvEdidVesaParamForce  & AvEdidBitVesaColor) ||
-           (AvEdidVesaParamRemove & AvEdidBitVesaColor))
+        if((EdidReg->VesaParamForce  & AvEdidBitVesaColor) ||
+           (EdidReg->VesaParamRemove & AvEdidBitVesaColor))
         {
             for(i=0;i<10;i++)
             {
@@ -575,7 +652,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                 }
             }
         }
-        if(AvEdidVesaParamForce  & AvEdidBitVesaTiming)
+        if(EdidReg->VesaParamForce  & AvEdidBitVesaTiming)
         {
             if(AvEdidSupportFrameRate & AvEdidBitFrameRate60HZ)
             {
@@ -615,7 +692,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                 OutEdid[35] = OutEdid[35] | (1<<6);
             }
         }
-        else if(AvEdidVesaParamRemove & AvEdidBitVesaTiming)
+        else if(EdidReg->VesaParamRemove & AvEdidBitVesaTiming)
         {
             OutEdid[35] = 1<<5;
             OutEdid[36] = 0;
@@ -642,7 +719,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                 OutEdid[37] = 0;
             }
         }
-        if(AvEdidVesaParamForce  & AvEdidBitVesaStandardTIMING)
+        if(EdidReg->VesaParamForce  & AvEdidBitVesaStandardTIMING)
         {
             for(i=0;i<16;i++)
             {
@@ -668,7 +745,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                 }
             }
         }
-        else if(AvEdidVesaParamRemove & AvEdidBitVesaStandardTIMING)
+        else if(EdidReg->VesaParamRemove & AvEdidBitVesaStandardTIMING)
         {
             for(i=0;i<16;i++)
             {
@@ -710,31 +787,31 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                 }
             }
         }
-        if(AvEdidSupportFreq & AvEdidBitFreq6G)
+        if(EdidReg->SupportFreq & AvEdidBitFreq6G)
         {
             EdidReg->VesaMaxClk = 600;
         }
-        else if(AvEdidSupportFreq & AvEdidBitFreq4P5G)
+        else if(EdidReg->SupportFreq & AvEdidBitFreq4P5G)
         {
             EdidReg->VesaMaxClk = 450;
         }
-        else if(AvEdidSupportFreq & AvEdidBitFreq3P75G)
+        else if(EdidReg->SupportFreq & AvEdidBitFreq3P75G)
         {
             EdidReg->VesaMaxClk = 380;
         }
-        else if(AvEdidSupportFreq & AvEdidBitFreq3G)
+        else if(EdidReg->SupportFreq & AvEdidBitFreq3G)
         {
             EdidReg->VesaMaxClk = 300;
         }
-        else if(AvEdidSupportFreq & AvEdidBitFreq2P25G)
+        else if(EdidReg->SupportFreq & AvEdidBitFreq2P25G)
         {
             EdidReg->VesaMaxClk = 230;
         }
-        else if(AvEdidSupportFreq & AvEdidBitFreq1P5G)
+        else if(EdidReg->SupportFreq & AvEdidBitFreq1P5G)
         {
             EdidReg->VesaMaxClk = 150;
         }
-        else if(AvEdidSupportFreq & AvEdidBitFreq750M)
+        else if(EdidReg->SupportFreq & AvEdidBitFreq750M)
         {
             EdidReg->VesaMaxClk = 80;
         }
@@ -754,7 +831,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                    (InEdid[0x48+i*18+3] == 0xfd))
                 {
                     InEdidLimitRange = i + 1;
-                    if((AvEdidVesaParamForce & AvEdidBitVesaMaxClk) == 0)
+                    if((EdidReg->VesaParamForce & AvEdidBitVesaMaxClk) == 0)
                     {
                         if(EdidReg->VesaMaxClk > InEdid[0x48+i*18+9]*10)
                         {
@@ -774,7 +851,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                    (SinkEdid[0x48+i*18+3] == 0xfd))
                 {
                     SinkEdidLimitRange = i + 1;
-                    if((AvEdidVesaParamForce & AvEdidBitVesaMaxClk) == 0)
+                    if((EdidReg->VesaParamForce & AvEdidBitVesaMaxClk) == 0)
                     {
                         if(EdidReg->VesaMaxClk > SinkEdid[0x48+i*18+9]*10)
                         {
@@ -788,7 +865,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         {
             EdidReg->VesaMaxClk = 150;
         }
-        if(AvEdidCeaParamForce & AvEdidBitCeaVSDBHF)
+        if(EdidReg->CeaParamForce & AvEdidBitCeaVSDBHF)
         {
             EdidReg->VesaMaxClk = 600;
         }
@@ -1047,11 +1124,11 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         }
         if((InEdidExist == 0) && (SinkEdidExist == 0))
         {
-            if(AvEdidSupportFreq & (AvEdidBitFreq6G | AvEdidBitFreq4P5G | AvEdidBitFreq3P75G))
+            if(EdidReg->SupportFreq & (AvEdidBitFreq6G | AvEdidBitFreq4P5G | AvEdidBitFreq3P75G))
             {
                 VsdbHfForceFlag = 1;
             }
-            if((AvEdidSupportFreq & AvEdidBitFreq3G) & (AvEdidSupportColorSpace & AvEdidBitColorSpaceY420))
+            if((EdidReg->SupportFreq & AvEdidBitFreq3G) & (AvEdidSupportColorSpace & AvEdidBitColorSpaceY420))
             {
                 Db420ForceFlag = 1;
             }
@@ -1064,11 +1141,11 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         sCeabParam = 0;
         oLen    = 0;
         oOffset = 0x84;
-        if(AvEdidCeaParamForce  & AvEdidBitCeaSVD)
+        if(EdidReg->CeaParamForce  & AvEdidBitCeaSVD)
         {
             oLen       = AvEdidFuncCeabSVD(EdidReg, InEdid, iCeabParam, SinkEdid, sCeabParam, OutEdid, oOffset);
         }
-        else if(AvEdidCeaParamRemove & AvEdidBitCeaSVD)
+        else if(EdidReg->CeaParamRemove & AvEdidBitCeaSVD)
         {
             oLen       = 0;
         }
@@ -1086,11 +1163,11 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         sCeabParam = 0;
         oLen    = 0;
         oOffset = OutEdidCeabOffset;
-        if(AvEdidCeaParamForce  & AvEdidBitCeaAUDIO)
+        if(EdidReg->CeaParamForce  & AvEdidBitCeaAUDIO)
         {
             oLen       = AvEdidFuncCeabAudio(EdidReg, InEdid, iCeabParam, SinkEdid, sCeabParam, OutEdid, oOffset);
         }
-        else if(AvEdidCeaParamRemove & AvEdidBitCeaAUDIO)
+        else if(EdidReg->CeaParamRemove & AvEdidBitCeaAUDIO)
         {
             oLen       = 0;
         }
@@ -1108,11 +1185,11 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         sCeabParam = 0;
         oLen    = 0;
         oOffset = OutEdidCeabOffset;
-        if(AvEdidCeaParamForce  & AvEdidBitCeaVSDBHDMI)
+        if(EdidReg->CeaParamForce  & AvEdidBitCeaVSDBHDMI)
         {
             oLen       = AvEdidFuncCeabVsdbHdmi(EdidReg, InEdid, iCeabParam, SinkEdid, sCeabParam, OutEdid, oOffset);
         }
-        else if(AvEdidCeaParamRemove & AvEdidBitCeaVSDBHDMI)
+        else if(EdidReg->CeaParamRemove & AvEdidBitCeaVSDBHDMI)
         {
             oLen       = 0;
         }
@@ -1126,17 +1203,17 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         {
             OutEdidCeabOffset = oOffset + 1 + oLen;
         }
-        if(AvEdidSupportFreq & (AvEdidBitFreq6G | AvEdidBitFreq4P5G | AvEdidBitFreq3P75G))
+        if(EdidReg->SupportFreq & (AvEdidBitFreq6G | AvEdidBitFreq4P5G | AvEdidBitFreq3P75G))
         {
             iCeabParam = 0;
             sCeabParam = 0;
             oLen    = 0;
             oOffset = OutEdidCeabOffset;
-            if((AvEdidCeaParamForce  & AvEdidBitCeaVSDBHF) || (VsdbHfForceFlag == 1))
+            if((EdidReg->CeaParamForce  & AvEdidBitCeaVSDBHF) || (VsdbHfForceFlag == 1))
             {
                 oLen       = AvEdidFuncCeabVsdbHf(EdidReg, InEdid, iCeabParam, SinkEdid, sCeabParam, OutEdid, oOffset);
             }
-            else if(AvEdidCeaParamRemove & AvEdidBitCeaVSDBHF)
+            else if(EdidReg->CeaParamRemove & AvEdidBitCeaVSDBHF)
             {
                 oLen       = 0;
             }
@@ -1159,11 +1236,11 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         sCeabParam = 0;
         oLen    = 0;
         oOffset = OutEdidCeabOffset;
-        if(AvEdidCeabParamForce  & AvEdidBitCeabVCDB)
+        if(EdidReg->CeabParamForce  & AvEdidBitCeabVCDB)
         {
             oLen       = AvEdidFuncCeabVcdb(EdidReg, InEdid, iCeabParam, SinkEdid, sCeabParam, OutEdid, oOffset);
         }
-        else if(AvEdidCeabParamRemove & AvEdidBitCeabVCDB)
+        else if(EdidReg->CeabParamRemove & AvEdidBitCeabVCDB)
         {
             oLen       = 0;
         }
@@ -1181,11 +1258,11 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         sCeabParam = 0;
         oLen    = 0;
         oOffset = OutEdidCeabOffset;
-        if(AvEdidCeabParamForce  & AvEdidBitCeabCDB)
+        if(EdidReg->CeabParamForce  & AvEdidBitCeabCDB)
         {
             oLen       = AvEdidFuncCeabCdb(EdidReg, InEdid, iCeabParam, SinkEdid, sCeabParam, OutEdid, oOffset);
         }
-        else if(AvEdidCeabParamRemove & AvEdidBitCeabCDB)
+        else if(EdidReg->CeabParamRemove & AvEdidBitCeabCDB)
         {
             oLen       = 0;
         }
@@ -1207,11 +1284,11 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         sCeabParam = 0;
         oLen    = 0;
         oOffset = OutEdidCeabOffset;
-        if((AvEdidCeabParamForce  & AvEdidBitCeabHDR_STATIC) || (HdrForceFlag == 1))
+        if((EdidReg->CeabParamForce  & AvEdidBitCeabHDR_STATIC) || (HdrForceFlag == 1))
         {
             oLen       = AvEdidFuncCeabHdrSt(EdidReg, InEdid, iCeabParam, SinkEdid, sCeabParam, OutEdid, oOffset);
         }
-        else if(AvEdidCeabParamRemove & AvEdidBitCeabHDR_STATIC)
+        else if(EdidReg->CeabParamRemove & AvEdidBitCeabHDR_STATIC)
         {
             oLen       = 0;
         }
@@ -1235,13 +1312,13 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
             sCeabParam = 0;
             oLen    = 0;
             oOffset = OutEdidCeabOffset;
-            if(AvEdidSupportFreq & AvEdidBitFreq6G)
+            if(EdidReg->SupportFreq & AvEdidBitFreq6G)
             {
-                if((AvEdidCeabParamForce  & AvEdidBitCeabY420CMDB) || (Db420ForceFlag == 1))
+                if((EdidReg->CeabParamForce  & AvEdidBitCeabY420CMDB) || (Db420ForceFlag == 1))
                 {
                     oLen   = AvEdidFuncCeabY420Cmdb(EdidReg, InEdid, iCeabParam, SinkEdid, sCeabParam, OutEdid, oOffset);
                 }
-                else if(AvEdidCeabParamRemove & AvEdidBitCeabY420CMDB)
+                else if(EdidReg->CeabParamRemove & AvEdidBitCeabY420CMDB)
                 {
                     oLen   = 0;
                 }
@@ -1306,13 +1383,13 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                     }
                 }
             }
-            else if(AvEdidSupportFreq & (AvEdidBitFreq4P5G | AvEdidBitFreq3P75G | AvEdidBitFreq3G))
+            else if(EdidReg->SupportFreq & (AvEdidBitFreq4P5G | AvEdidBitFreq3P75G | AvEdidBitFreq3G))
             {
-                if((AvEdidCeabParamForce  & AvEdidBitCeabY420VDB) || (Db420ForceFlag == 1))
+                if((EdidReg->CeabParamForce  & AvEdidBitCeabY420VDB) || (Db420ForceFlag == 1))
                 {
                     oLen   = AvEdidFuncCeabY420Vdb(EdidReg, InEdid, iCeabParam, SinkEdid, sCeabParam, OutEdid, oOffset);
                 }
-                else if(AvEdidCeabParamRemove & AvEdidBitCeabY420VDB)
+                else if(EdidReg->CeabParamRemove & AvEdidBitCeabY420VDB)
                 {
                     oLen   = 0;
                 }
@@ -1344,11 +1421,11 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         sCeabParam = 0;
         oLen    = 0;
         oOffset = OutEdidCeabOffset;
-        if(AvEdidCeabParamForce  & AvEdidBitCeabHDR_DOLBYVISION)
+        if(EdidReg->CeabParamForce  & AvEdidBitCeabHDR_DOLBYVISION)
         {
             oLen       = AvEdidFuncCeabDolbyVisionSt(EdidReg, InEdid, iCeabParam, SinkEdid, sCeabParam, OutEdid, oOffset);
         }
-        else if(AvEdidCeabParamRemove & AvEdidBitCeabHDR_DOLBYVISION)
+        else if(EdidReg->CeabParamRemove & AvEdidBitCeabHDR_DOLBYVISION)
         {
             oLen       = 0;
         }
@@ -1508,31 +1585,31 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         uint8   bLen = 0;
         uint8   VicNum = 0;
         uint8   NativeFlag = 0;
-        if(AvEdidSupportFreq & AvEdidBitFreq6G)
+        if(EdidReg->SupportFreq & AvEdidBitFreq6G)
         {
             AvEdidFuncBulkAddValue(EdidReg->EdidCeaVicCheck, 4, 0, 1);
         }
-        if(AvEdidSupportFreq & (AvEdidBitFreq4P5G | AvEdidBitFreq3P75G | AvEdidBitFreq3G))
+        if(EdidReg->SupportFreq & (AvEdidBitFreq4P5G | AvEdidBitFreq3P75G | AvEdidBitFreq3G))
         {
             AvEdidFuncBulkAddValue(EdidReg->EdidCeaVicCheck, 6, 4, 1);
-            if((AvEdidSupportColorSpace & AvEdidBitColorSpaceY420) && ((AvEdidSupportFreq & AvEdidBitFreq6G) == 0))
+            if((AvEdidSupportColorSpace & AvEdidBitColorSpaceY420) && ((EdidReg->SupportFreq & AvEdidBitFreq6G) == 0))
             {
                 AvEdidFuncBulkAddValue(EdidReg->EdidCeaVicCheck, 4, 0, 1);
             }
         }
-        if(AvEdidSupportFreq & (AvEdidBitFreq2P25G | AvEdidBitFreq1P5G))
+        if(EdidReg->SupportFreq & (AvEdidBitFreq2P25G | AvEdidBitFreq1P5G))
         {
             AvEdidFuncBulkAddValue(EdidReg->EdidCeaVicCheck, 2, 10, 1);
         }
-        if(AvEdidSupportFreq & AvEdidBitFreq750M)
+        if(EdidReg->SupportFreq & AvEdidBitFreq750M)
         {
             AvEdidFuncBulkAddValue(EdidReg->EdidCeaVicCheck, 7, 12, 1);
         }
-        if(AvEdidSupportFreq & AvEdidBitFreq270M)
+        if(EdidReg->SupportFreq & AvEdidBitFreq270M)
         {
             AvEdidFuncBulkAddValue(EdidReg->EdidCeaVicCheck, 2, 19, 1);
         }
-        if(AvEdidSupportFreq & AvEdidBitFreq135M)
+        if(EdidReg->SupportFreq & AvEdidBitFreq135M)
         {
             AvEdidFuncBulkAddValue(EdidReg->EdidCeaVicCheck, 2, 21, 1);
         }
@@ -1601,14 +1678,14 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         {
             SelectValue = SelectValue + 1;
         }
-        if(AvEdidCeaParamRemove & AvEdidBitCeaNATIVE)
+        if(EdidReg->CeaParamRemove & AvEdidBitCeaNATIVE)
         {
             OutNativeVic = 0;
         }
         else
         {
             OutNativeVic = AvEdidNativeVic;
-            if((AvEdidCeaParamForce  & AvEdidBitCeaNATIVE) == 0)
+            if((EdidReg->CeaParamForce  & AvEdidBitCeaNATIVE) == 0)
             {
                 if(InEdidNativeVic != 0)
                 {
@@ -2286,7 +2363,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         {
             EdidReg->VsdbCheckList[3] = 1;
         }
-        if(AvEdidSupportFreq & AvEdidBitFreq3G)
+        if(EdidReg->SupportFreq & AvEdidBitFreq3G)
         {
             if(AvEdidSupportFrameRate & AvEdidBitFrameRate30HZ)
             {
@@ -2334,19 +2411,19 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         {
             EdidReg->VsdbCheckList[15] = 1;
         }
-        if(AvEdidSupportFreq & (AvEdidBitFreq6G | AvEdidBitFreq4P5G | AvEdidBitFreq3P75G | AvEdidBitFreq3G))
+        if(EdidReg->SupportFreq & (AvEdidBitFreq6G | AvEdidBitFreq4P5G | AvEdidBitFreq3P75G | AvEdidBitFreq3G))
         {
             EdidReg->MaxTmdsClk = 340;
         }
-        else if(AvEdidSupportFreq & AvEdidBitFreq2P25G)
+        else if(EdidReg->SupportFreq & AvEdidBitFreq2P25G)
         {
             EdidReg->MaxTmdsClk = 225;
         }
-        else if(AvEdidSupportFreq & AvEdidBitFreq1P5G)
+        else if(EdidReg->SupportFreq & AvEdidBitFreq1P5G)
         {
             EdidReg->MaxTmdsClk = 150;
         }
-        else if(AvEdidSupportFreq & AvEdidBitFreq750M)
+        else if(EdidReg->SupportFreq & AvEdidBitFreq750M)
         {
             EdidReg->MaxTmdsClk = 75;
         }
@@ -2362,7 +2439,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         {
             AvEdidFuncCeabVsdbHdmiRead(EdidReg, SinkEdid, SinkEdidOffset);
         }
-        if(AvEdidCeaParamForce & AvEdidBitCeaVSDBHF)
+        if(EdidReg->CeaParamForce & AvEdidBitCeaVSDBHF)
         {
             EdidReg->MaxTmdsClk = 340;
         }
@@ -2379,8 +2456,8 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         OutEdid[OutEdidOffset+2] = EdidCeaIdVsdbHdmi[1];
         OutEdid[OutEdidOffset+3] = EdidCeaIdVsdbHdmi[2];
         if((SelectValue == 1) ||
-           ((AvEdidCeaParamForce & AvEdidBitCeaSPA) != 0) ||
-           ((AvEdidCeaParamRemove & AvEdidBitCeaSPA) != 0))
+           ((EdidReg->CeaParamForce & AvEdidBitCeaSPA) != 0) ||
+           ((EdidReg->CeaParamRemove & AvEdidBitCeaSPA) != 0))
         {
             OutEdid[OutEdidOffset+4] = (AvEdidVsdbSpa>>8) & 0xff;
             OutEdid[OutEdidOffset+5] = (AvEdidVsdbSpa>>0) & 0xff;
@@ -2483,15 +2560,15 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         uint8   InEdidOffset   = (InCeabParam>>8)&0xff;
         uint8   SinkEdidOffset = (SinkCeabParam>>8)&0xff;
         uint8   SelectValue = 0;
-        if(AvEdidSupportFreq & AvEdidBitFreq6G)
+        if(EdidReg->SupportFreq & AvEdidBitFreq6G)
         {
             EdidReg->MaxCharRate = 600;
         }
-        else if(AvEdidSupportFreq & AvEdidBitFreq4P5G)
+        else if(EdidReg->SupportFreq & AvEdidBitFreq4P5G)
         {
             EdidReg->MaxCharRate = 450;
         }
-        else if(AvEdidSupportFreq & AvEdidBitFreq3P75G)
+        else if(EdidReg->SupportFreq & AvEdidBitFreq3P75G)
         {
             EdidReg->MaxCharRate = 375;
         }
@@ -2505,7 +2582,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         EdidReg->HfDscFrlRate = AvEdidDscFrlRate;
         EdidReg->HfDscMaxSlices = AvEdidDscMaxSlices;
         EdidReg->HfDscTotalChunkKBytes = AvEdidDscTotalChunkKBytes;
-        if(AvEdidSupportFreq & AvEdidBitFreq6G)
+        if(EdidReg->SupportFreq & AvEdidBitFreq6G)
         {
             if(AvEdidSupportColorSpace & AvEdidBitColorSpaceY420)
             {
@@ -2515,7 +2592,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                 }
             }
         }
-        if(AvEdidSupportFreq & AvEdidBitFreq4P5G)
+        if(EdidReg->SupportFreq & AvEdidBitFreq4P5G)
         {
             if(AvEdidSupportColorSpace & AvEdidBitColorSpaceY420)
             {
@@ -2525,7 +2602,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
                 }
             }
         }
-        if(AvEdidSupportFreq & AvEdidBitFreq3P75G)
+        if(EdidReg->SupportFreq & AvEdidBitFreq3P75G)
         {
             if(AvEdidSupportColorSpace & AvEdidBitColorSpaceY420)
             {
@@ -2818,7 +2895,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         uint8   MarkLen = bLen;
         uint8   SvdOffset = 0;
         uint8   SvdLen = 0;
-        if(AvEdidSupportFreq & AvEdidBitFreq6G)
+        if(EdidReg->SupportFreq & AvEdidBitFreq6G)
         {
             if(AvEdidSupportFrameRate & AvEdidBitFrameRate50HZ)
             {
@@ -2887,7 +2964,7 @@ void AvEdidFuncStructInit(AvEdidReg *EdidReg)
         uint8   SinkEdidOffset = (SinkCeabParam>>8)&0xff;
         uint8   SelectValue = 0;
         uint8   bLen = 1;
-        if(AvEdidSupportFreq & (AvEdidBitFreq6G | AvEdidBitFreq4P5G | AvEdidBitFreq3P75G | AvEdidBitFreq3G))
+        if(EdidReg->SupportFreq & (AvEdidBitFreq6G | AvEdidBitFreq4P5G | AvEdidBitFreq3P75G | AvEdidBitFreq3G))
         {
             if(AvEdidSupportFrameRate & AvEdidBitFrameRate50HZ)
             {
@@ -220,9 +220,49 @@ typedef struct
     uint8  HdrStCheck [4];
     uint8  CdbCheck [9];
     uint8  DolbyVisionCheck;
+    /* merge parameters, kept by AvEdidFuncStructInit */
+    uint16 SupportFreq;
+    uint16 VesaParamForce;
+    uint16 CeabParamForce;
+    uint16 VesaParamRemove;
+    uint16 CeabParamRemove;
+    uint8  CeaParamForce;
+    uint8  CeaParamRemove;
 } AvEdidReg;
+
+/* generated edid of a known set of sinks */
+typedef struct
+{
+    uint32 Key;                  /* sink edid and merge parameter fingerprint, 0 if free */
+    uint8  SpaLocation;
+    uint8  SpaValue[2];          /* spa found in OutEdid, before source spa generation */
+    uint8  OutEdid[256];
+} AvEdidCacheEntry;
+
+/* edid merge workspace of one device, hung on device->edid */
+typedef struct
+{
+    AvEdidReg Reg;
+    uint8  InEdid[256];
+    uint8  SinkEdid[256];
+    uint8  OutEdid[256];
+#if AvEdidCacheEntries
+    AvEdidCacheEntry Cache[AvEdidCacheEntries];
+    uint8  CacheNext;            /* next entry to replace */
+    uint32 RxRamKey[4];          /* key of the edid held in each rx edid ram, 0 if unknown */
+    uint8  RxRamSpa[4][2];       /* spa written along with it */
+#endif
+} AvEdidWorkspace;
 /* EDID Structure Declare End */
     void AvEdidFuncStructInit(AvEdidReg *EdidReg);
+    void AvEdidFuncParamInit(AvEdidReg *EdidReg);
+    void AvEdidFuncMerge(AvEdidReg *EdidReg,uint8 *InEdid,uint8 *SinkEdid,uint8 *OutEdid);
+#if AvEdidCacheEntries
+    uint32 AvEdidFuncFingerprint(uint32 Hash,uint8 *Data,uint16 Length);
+    AvEdidCacheEntry *AvEdidFuncCacheLookup(AvEdidWorkspace *Edid,uint32 Key);
+    void AvEdidFuncCacheStore(AvEdidWorkspace *Edid,uint32 Key,uint8 *OutEdid,uint8 SpaLocation,uint8 *SpaValue);
+    void AvEdidFuncCacheRamLost(AvEdidWorkspace *Edid);
+#endif
     void AvEdidFuncBulkAddValue(uint8 *table,uint8 total,uint8 start,uint8 value);
     void AvEdidFuncBulkDropValue(uint8 *table,uint8 total,uint8 start,uint8 value);
     void AvEdidFuncBulkWriteData(AvEdidReg *EdidReg,uint8 total,uint8 *FromTable,uint8 FromOffset,uint8 *OutEdid,uint8 ToOffset);
@@ -12,24 +12,12 @@ uint8  LogicOutputSel  = 1;
 extern uchar  DevicePowerStatus;
 extern char   DeviceName[20];
 extern uchar  AudioStatus;
-extern CEC_AUDIO_STATUS Cec_Tx_Audio_Status;
 uint16 AvCecFindRequiredInput (AvPort *port, uint16 SrcPhys);
 #endif
 
 /* Edid Related Declare Start */
-extern AvEdidReg DevEdidReg;
-extern uint16    AvEdidSupportFreq;
-extern uint8     AvEdidVesaParamForce;
-extern uint8     AvEdidCeaParamForce;
-extern uint16    AvEdidCeabParamForce;
-extern uint8     AvEdidVesaParamRemove;
-extern uint8     AvEdidCeaParamRemove;
-extern uint16    AvEdidCeabParamRemove;
-uint8 InEdid[256];
-uint8 SinkEdid[256];
-uint8 OutEdid[256];
 AvRet AvEdidPortManage(AvPort *RxPort);
-AvRet AvEdidPortAnalysis(AvPort *port);
+AvRet AvEdidPortAnalysis(AvPort *port, uint8 *ReadEdid);
 /* Edid Related Declare End */
 
 /**
@@ -141,15 +129,14 @@ AvRet AvHandleEvent(AvPort *port, AvEvent event, uint8 *wparam, uint8 *pparam)
             break;
 
         case AvEventRxPrepareEdid:
-            if(port->content.rx->EdidStatus != AV_EDID_UPDATED)
-            {
-                AvEdidPortManage(port);
+            /* a sink edid not ready yet is merged on the next tick */
+            if((port->content.rx->EdidStatus != AV_EDID_UPDATED) &&
+               (AvEdidPortManage(port) != AvNotAvailable))
                 port->content.rx->EdidStatus = AV_EDID_UPDATED;
-            }
             break;
 
         case AvEventPortEdidReady:
-            AvEdidPortAnalysis(port);
+            AvEdidPortAnalysis(port, wparam);
             /* Resend Edid */
             if(KfunFindVideoRxFront(port, &TempPort) == AvOk)
             {
@@ -407,7 +394,7 @@ AvRet AvHandleEvent(AvPort *port, AvEvent event, uint8 *wparam, uint8 *pparam)
             AV_CEC_SET_OPCODE(TxContent, AV_CEC_MSG_SET_SYSTEM_AUDIO_MODE);
             TxContent[2] = AudioStatus;
             AvKapiCecSendMessage(port);
-            Cec_Tx_Audio_Status.AudioMode = AudioStatus;
+            port->content.cec->AudioState.AudioMode = AudioStatus;
             break;
 
         case AvEventCecSendSetSystemAudioModeToAll:
@@ -418,7 +405,7 @@ AvRet AvHandleEvent(AvPort *port, AvEvent event, uint8 *wparam, uint8 *pparam)
             AV_CEC_SET_OPCODE(TxContent, AV_CEC_MSG_SET_SYSTEM_AUDIO_MODE);
             TxContent[2] = AudioStatus;
             AvKapiCecSendMessage(port);
-            Cec_Tx_Audio_Status.AudioMode = AudioStatus;
+            port->content.cec->AudioState.AudioMode = AudioStatus;
             break;
 
         case AvEventCecSendReportAudioStatus:
@@ -429,9 +416,9 @@ AvRet AvHandleEvent(AvPort *port, AvEvent event, uint8 *wparam, uint8 *pparam)
             AV_CEC_SET_HDR_DA(TxContent, AV_CEC_SRC(RxContent), port->content.cec->LogAddr);
             AV_CEC_SET_OPCODE(TxContent, AV_CEC_MSG_REPORT_AUDIO_STATUS);
             /* AV_CEC_AUDIO_MUTE_SHIFTER = bit 7 */
-            TxContent[2] = Cec_Tx_Audio_Status.Mute << 7;
+            TxContent[2] = port->content.cec->AudioState.Mute << 7;
             /* CEC_AUDIO_MASK_MUTE_BIT = 0x7f */
-            TxContent[2] = TxContent[2] | (Cec_Tx_Audio_Status.Volume & 0x7f);
+            TxContent[2] = TxContent[2] | (port->content.cec->AudioState.Volume & 0x7f);
             AvKapiOutputDebugMessage("CEC: Sending audio status");
             AvKapiCecSendMessage(port);
             break;
@@ -443,7 +430,7 @@ AvRet AvHandleEvent(AvPort *port, AvEvent event, uint8 *wparam, uint8 *pparam)
             /* Directly addressed */
             AV_CEC_SET_HDR_DA(TxContent, AV_CEC_SRC(RxContent), port->content.cec->LogAddr);
             AV_CEC_SET_OPCODE(TxContent, AV_CEC_MSG_SYSTEM_AUDIO_MODE_STATUS);
-            TxContent[2] = Cec_Tx_Audio_Status.AudioMode;        /* audio mode status      */
+            TxContent[2] = port->content.cec->AudioState.AudioMode;        /* audio mode status      */
             AvKapiOutputDebugMessage("CEC: Sending audio mode status");
             AvKapiCecSendMessage(port);
             break;
@@ -457,9 +444,9 @@ AvRet AvHandleEvent(AvPort *port, AvEvent event, uint8 *wparam, uint8 *pparam)
             AV_CEC_SET_HDR_DA(TxContent, AV_CEC_SRC(RxContent), port->content.cec->LogAddr);
             AV_CEC_SET_OPCODE(TxContent, AV_CEC_MSG_REPORT_SHORT_AUDIO_DESCRIPTOR);
 
-            TxContent[2] = (Cec_Tx_Audio_Status.MaxNumberOfChannels-1) | ( (Cec_Tx_Audio_Status.AudioFormatCode) << 3);
-            TxContent[3] = Cec_Tx_Audio_Status.AudioSampleRate;          /* audio  capability 2      */
-            TxContent[4] = Cec_Tx_Audio_Status.AudioBitLen;
+            TxContent[2] = (port->content.cec->AudioState.MaxNumberOfChannels-1) | ( (port->content.cec->AudioState.AudioFormatCode) << 3);
+            TxContent[3] = port->content.cec->AudioState.AudioSampleRate;          /* audio  capability 2      */
+            TxContent[4] = port->content.cec->AudioState.AudioBitLen;
             AvKapiOutputDebugMessage("CEC: Sending audio capability");
             AvKapiCecSendMessage(port);
             break;
@@ -470,55 +457,55 @@ AvRet AvHandleEvent(AvPort *port, AvEvent event, uint8 *wparam, uint8 *pparam)
 
         case AvEventCecReceiveSystemAudioModeStatus:
             /* reg setting from AvEventCecMsgSystemAudioModeStatus */
-            Cec_Tx_Audio_Status.AudioMode = RxContent[2];
+            port->content.cec->AudioState.AudioMode = RxContent[2];
             break;
 
         case AvEventCecReceiveSetSystemAudioMode:
             /* reg setting from AvEventCecMsgSetSystemAudioMode */
-            Cec_Tx_Audio_Status.Mute = AV_CEC_AUDIO_MUTE_ON;
+            port->content.cec->AudioState.Mute = AV_CEC_AUDIO_MUTE_ON;
             if (RxContent[2])
             {
-                Cec_Tx_Audio_Status.Mute = AV_CEC_AUDIO_MUTE_OFF;
+                port->content.cec->AudioState.Mute = AV_CEC_AUDIO_MUTE_OFF;
             }
-            Cec_Tx_Audio_Status.AudioMode = RxContent[2];
+            port->content.cec->AudioState.AudioMode = RxContent[2];
             break;
 
         case AvEventCecReceiveAudioStatus:
             /* reg setting from AvEventCecMsgReportAudioStatus */
             /* AV_CEC_AUDIO_MUTE_SHIFTER = bit 7 */
-            Cec_Tx_Audio_Status.Mute = RxContent[2] >> 7;
+            port->content.cec->AudioState.Mute = RxContent[2] >> 7;
             /* CEC_AUDIO_MASK_MUTE_BIT = 0x7f */
-            Cec_Tx_Audio_Status.Volume = RxContent[2] & 0x7f;
+            port->content.cec->AudioState.Volume = RxContent[2] & 0x7f;
             break;
 
         case AvEventCecReceiveSetAudioRate:
             /* reg setting from AvEventCecMsgSetAudioRate */
-            Cec_Tx_Audio_Status.AudioRate = RxContent[2];
+            port->content.cec->AudioState.AudioRate = RxContent[2];
             break;
 
         case AvEventCecReceiveShortAudioDescriptor:
             /* reg setting from AvEventCecMsgReportShortAudioDescriptor */
             /* AV_CEC_AUDIO_FORMAT_ID_SHIFTER = 3 */
-            Cec_Tx_Audio_Status.AudioFormatCode = RxContent[2] >> 3;
+            port->content.cec->AudioState.AudioFormatCode = RxContent[2] >> 3;
             /* CEC_AUDIO_MASK_AUDIOFORMATID_BIT = 0x07 */
-            Cec_Tx_Audio_Status.MaxNumberOfChannels = RxContent[2] & 0x07;
-            (Cec_Tx_Audio_Status.MaxNumberOfChannels)++;
+            port->content.cec->AudioState.MaxNumberOfChannels = RxContent[2] & 0x07;
+            (port->content.cec->AudioState.MaxNumberOfChannels)++;
             /* CEC_AUDIO_ENABLE_AUDIOSAMPLERATE_BIT = 0x7f */
-            Cec_Tx_Audio_Status.AudioSampleRate = RxContent[3] & 0x7f;
-            if ( Cec_Tx_Audio_Status.AudioFormatCode == AV_AUD_FORMAT_LINEAR_PCM)
+            port->content.cec->AudioState.AudioSampleRate = RxContent[3] & 0x7f;
+            if ( port->content.cec->AudioState.AudioFormatCode == AV_AUD_FORMAT_LINEAR_PCM)
             {
-                Cec_Tx_Audio_Status.AudioBitLen  = RxContent[4];
+                port->content.cec->AudioState.AudioBitLen  = RxContent[4];
             }
-            else if ( (Cec_Tx_Audio_Status.AudioFormatCode >= AV_AUD_FORMAT_AC3)
-                     && (Cec_Tx_Audio_Status.AudioFormatCode <= AV_AUD_FORMAT_AC3))
+            else if ( (port->content.cec->AudioState.AudioFormatCode >= AV_AUD_FORMAT_AC3)
+                     && (port->content.cec->AudioState.AudioFormatCode <= AV_AUD_FORMAT_AC3))
             {
-                Cec_Tx_Audio_Status.MaxBitRate  = ((uint16)RxContent[4]) << 3;
+                port->content.cec->AudioState.MaxBitRate  = ((uint16)RxContent[4]) << 3;
             }
             break;
 
         case AvEventCecSendActiveSourceToAudio:
             /* reg setting from AvEventCecMsgReportPhyAddr */
-            Cec_Tx_Audio_Status.ActiveSource = *wparam;
+            port->content.cec->AudioState.ActiveSource = *wparam;
             break;
 
         case AvEventCecSendInitiateARC:
@@ -892,13 +879,13 @@ AvRet AvHandleEvent(AvPort *port, AvEvent event, uint8 *wparam, uint8 *pparam)
                 switch(RxContent[2])
                 {
                     case 0x41: /* Volume Up */
-                        if(Cec_Tx_Audio_Status.Volume <= 100)
-                            Cec_Tx_Audio_Status.Volume = Cec_Tx_Audio_Status.Volume + 10;
+                        if(port->content.cec->AudioState.Volume <= 100)
+                            port->content.cec->AudioState.Volume = port->content.cec->AudioState.Volume + 10;
                         AvHandleEvent(port, AvEventCecSendReportAudioStatus, 0, NULL);
                         break;
                     case 0x42: /* Volume Down */
-                        if(Cec_Tx_Audio_Status.Volume >= 10)
-                            Cec_Tx_Audio_Status.Volume = Cec_Tx_Audio_Status.Volume - 10;
+                        if(port->content.cec->AudioState.Volume >= 10)
+                            port->content.cec->AudioState.Volume = port->content.cec->AudioState.Volume - 10;
                         AvHandleEvent(port, AvEventCecSendReportAudioStatus, 0, NULL);
                         break;
                     default:
@@ -1248,29 +1235,39 @@ uint16 AvCecFindRequiredInput (AvPort *port, uint16 SrcPhys)
 
 AvRet AvEdidPortManage(AvPort *RxPort)
 {
+    AvEdidWorkspace *Edid = (AvEdidWorkspace *)RxPort->device->edid;
+    AvEdidReg *DevEdidReg = &Edid->Reg;
+    uint8 *InEdid = Edid->InEdid;
+    uint8 *SinkEdid = Edid->SinkEdid;
+    uint8 *OutEdid = Edid->OutEdid;
     uint8 SpaLocation = 0;
     uint8 SpaValue[2];
     uint8 SinkNumber = 0; /* default to force mode */
     AvPort *CurrentPort = NULL;
     AvPort *PrevPort = NULL;
+    AvEdidCacheEntry *Entry = NULL;
     uint8 i=0;
+#if AvEdidCacheEntries
+    uint32 Key = 0;
+    uint8 RamIndex = RxPort->index & 0x03;
+#endif
 
     /* 1. Clear RAM header, save time */
     AvMemset(InEdid, 0, 256);
     AvMemset(SinkEdid, 0, 256);
     AvMemset(OutEdid, 0, 256);
     /* 1.1 Set Edid Parameter */
-    AvEdidSupportFreq = AvEdidBitFreq6G    |
-                        AvEdidBitFreq4P5G  |
-                        AvEdidBitFreq3P75G |
-                        AvEdidBitFreq3G    |
-                        AvEdidBitFreq2P25G |
-                        AvEdidBitFreq1P5G  |
-                        AvEdidBitFreq750M  |
-                        AvEdidBitFreq270M  |
-                        AvEdidBitFreq135M;
-    AvEdidCeaParamForce  =  0; // AvEdidBitCeaSVD | AvEdidBitCeaVSDBHF;
-    AvEdidCeaParamRemove =  0;
+    AvEdidFuncParamInit(DevEdidReg);
+#if AvEdidCacheEntries
+    /* 1.2 fingerprint the merge parameters, sink edids are added as they are read */
+    Key = AvEdidFuncFingerprint(Key, (uint8 *)&DevEdidReg->SupportFreq,     sizeof(DevEdidReg->SupportFreq));
+    Key = AvEdidFuncFingerprint(Key, (uint8 *)&DevEdidReg->VesaParamForce,  sizeof(DevEdidReg->VesaParamForce));
+    Key = AvEdidFuncFingerprint(Key, (uint8 *)&DevEdidReg->CeaParamForce,   sizeof(DevEdidReg->CeaParamForce));
+    Key = AvEdidFuncFingerprint(Key, (uint8 *)&DevEdidReg->CeabParamForce,  sizeof(DevEdidReg->CeabParamForce));
+    Key = AvEdidFuncFingerprint(Key, (uint8 *)&DevEdidReg->VesaParamRemove, sizeof(DevEdidReg->VesaParamRemove));
+    Key = AvEdidFuncFingerprint(Key, (uint8 *)&DevEdidReg->CeaParamRemove,  sizeof(DevEdidReg->CeaParamRemove));
+    Key = AvEdidFuncFingerprint(Key, (uint8 *)&DevEdidReg->CeabParamRemove, sizeof(DevEdidReg->CeabParamRemove));
+#endif
 
     /* 2. Look up front port */
     CurrentPort = NULL;
@@ -1289,15 +1286,23 @@ AvRet AvEdidPortManage(AvPort *RxPort)
             AvKapiOutputDebugMessage("Rx %d Edid Manage: Read Tx %d EDID",RxPort->index+1, CurrentPort->index-3);
             /* find the next Edid Ram Ptr */
             if(SinkNumber == 1)
-                KfunTxReadEdid(CurrentPort,InEdid);
+            {
+                if(KfunTxReadEdid(CurrentPort,InEdid) == AvNotAvailable)
+                    return AvNotAvailable;
+#if AvEdidCacheEntries
+                Key = AvEdidFuncFingerprint(Key, InEdid, 256);
+#endif
+            }
             else
             {
-                KfunTxReadEdid(CurrentPort,SinkEdid);
+                if(KfunTxReadEdid(CurrentPort,SinkEdid) == AvNotAvailable)
+                    return AvNotAvailable;
+#if AvEdidCacheEntries
+                Key = AvEdidFuncFingerprint(Key, SinkEdid, 256);
+#endif
                 /* Merge Edids */
-                AvEdidFuncStructInit(&DevEdidReg);
                 AvMemset(OutEdid, 0, 256);
-                AvEdidFuncVesaProcess(&DevEdidReg,InEdid,SinkEdid,OutEdid);
-                AvEdidFuncCeaProcess(&DevEdidReg,InEdid,SinkEdid,OutEdid);
+                AvEdidFuncMerge(DevEdidReg,InEdid,SinkEdid,OutEdid);
                 AvMemcpy(InEdid,OutEdid,256);
                 AvMemset(SinkEdid, 0, 256);
             }
@@ -1305,18 +1310,32 @@ AvRet AvEdidPortManage(AvPort *RxPort)
         PrevPort = CurrentPort;
     }
 
-    /* 3. Final Merge Process */
-    if(SinkNumber <= 1)
+    /* 3. Final Merge Process, a known set of sinks reuses its generated Edid */
+#if AvEdidCacheEntries
+    Entry = AvEdidFuncCacheLookup(Edid, Key);
+#endif
+    if(Entry != NULL)
     {
-        AvEdidFuncStructInit(&DevEdidReg);
-        AvEdidFuncVesaProcess(&DevEdidReg,InEdid,SinkEdid,OutEdid);
-        AvEdidFuncCeaProcess(&DevEdidReg,InEdid,SinkEdid,OutEdid);
+        AvKapiOutputDebugMessage("Rx %d Edid Manage: Reuse Generated Edid",RxPort->index+1);
+        AvMemcpy(OutEdid, Entry->OutEdid, 256);
+        SpaLocation = Entry->SpaLocation;
+        SpaValue[0] = Entry->SpaValue[0];
+        SpaValue[1] = Entry->SpaValue[1];
+    }
+    else
+    {
+        if(SinkNumber <= 1)
+            AvEdidFuncMerge(DevEdidReg,InEdid,SinkEdid,OutEdid);
+        //AvMemcpy(OutEdid+0,(void*)(&AvDefaultEDID[0]),256);
+        AvEdidFuncCheckSum(OutEdid);
+        /* 4. Find Spa Location */
+        SpaLocation = KfunFindCecSPAFromEdid(OutEdid, SpaValue);
+#if AvEdidCacheEntries
+        AvEdidFuncCacheStore(Edid, Key, OutEdid, SpaLocation, SpaValue);
+#endif
     }
-    //AvMemcpy(OutEdid+0,(void*)(&AvDefaultEDID[0]),256);
-    AvEdidFuncCheckSum(OutEdid);
 
-    /* 4. Find Spa Location and generate its own SPA for source */
-    SpaLocation = KfunFindCecSPAFromEdid(OutEdid, SpaValue);
+    /* 4.1 generate its own SPA for source */
     KfunGenerateSourceSpa(RxPort, SpaValue, 0);
 
     AvKapiOutputDebugMessage("Rx %d Generated Edid Start: ",RxPort->index+1);
@@ -1330,19 +1349,38 @@ AvRet AvEdidPortManage(AvPort *RxPort)
     }
 
     /* 5. write Edid, set rx->EdidStatus to AV_EDID_NEEDUPDATE */
+#if AvEdidCacheEntries
+    /* 5.1 skip the RAM write when it already holds this Edid and Spa */
+    if((Edid->RxRamKey[RamIndex] == Key) &&
+       (Edid->RxRamSpa[RamIndex][0] == SpaValue[0]) &&
+       (Edid->RxRamSpa[RamIndex][1] == SpaValue[1]))
+        AvKapiOutputDebugMessage("Rx %d Edid Manage: Edid Ram Up To Date",RxPort->index+1);
+    else
+    {
+        Edid->RxRamKey[RamIndex] = Key;
+        Edid->RxRamSpa[RamIndex][0] = SpaValue[0];
+        Edid->RxRamSpa[RamIndex][1] = SpaValue[1];
+        KfunRxWriteEdid(RxPort, OutEdid, SpaLocation, SpaValue);
+    }
+#else
     KfunRxWriteEdid(RxPort, OutEdid, SpaLocation, SpaValue);
+#endif
     RxPort->content.rx->EdidStatus = AV_EDID_UPDATED;
 
     return AvOk;
 }
 
-AvRet AvEdidPortAnalysis(AvPort *port)
+AvRet AvEdidPortAnalysis(AvPort *port, uint8 *ReadEdid)
 {
+    AvEdidWorkspace *Edid = (AvEdidWorkspace *)port->device->edid;
+    AvEdidReg *DevEdidReg = &Edid->Reg;
+    uint8 *InEdid = Edid->InEdid;
     uint8 i=0;
 
-    KfunTxReadEdid(port,InEdid);
-    AvEdidFuncStructInit(&DevEdidReg);
-    AvEdidFunFullAnalysis(&DevEdidReg,InEdid);
+    /* the edid the event was raised with, just read and checked */
+    AvMemcpy(InEdid, ReadEdid, 256);
+    AvEdidFuncStructInit(DevEdidReg);
+    AvEdidFunFullAnalysis(DevEdidReg,InEdid);
 
     AvKapiOutputDebugMessage("Tx %d Read Edid Start: ",port->index-3);
     for(i=0;i<16;i++)
@@ -1354,65 +1392,65 @@ AvRet AvEdidPortAnalysis(AvPort *port)
                                  InEdid[i*16+12],InEdid[i*16+13],InEdid[i*16+14],InEdid[i*16+15]);
     }
 
-    if(DevEdidReg.MaxTmdsClk == 0)
+    if(DevEdidReg->MaxTmdsClk == 0)
     {
-        DevEdidReg.MaxTmdsClk  = DevEdidReg.VesaMaxClk;
-        DevEdidReg.MaxCharRate = DevEdidReg.VesaMaxClk;
+        DevEdidReg->MaxTmdsClk  = DevEdidReg->VesaMaxClk;
+        DevEdidReg->MaxCharRate = DevEdidReg->VesaMaxClk;
     }
     /* Feature Support */
     port->content.tx->EdidSupportFeature = AV_BIT_FEAT_1G5;
-    if((DevEdidReg.VsdbHfCheck[3] == 1) || (DevEdidReg.MaxTmdsClk > 340) || (DevEdidReg.MaxCharRate > 340) || (DevEdidReg.VesaMaxClk > 340))
+    if((DevEdidReg->VsdbHfCheck[3] == 1) || (DevEdidReg->MaxTmdsClk > 340) || (DevEdidReg->MaxCharRate > 340) || (DevEdidReg->VesaMaxClk > 340))
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_SCDC;
-    if(DevEdidReg.VsdbHfCheck[8] == 1)
+    if(DevEdidReg->VsdbHfCheck[8] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_RR;
-    if(DevEdidReg.VsdbHfCheck[7] == 1)
+    if(DevEdidReg->VsdbHfCheck[7] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_B340MSCR;
-    if(DevEdidReg.VsdbHfCheck[1] == 1)
+    if(DevEdidReg->VsdbHfCheck[1] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_36B420;
-    if(DevEdidReg.VsdbHfCheck[2] == 1)
+    if(DevEdidReg->VsdbHfCheck[2] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_30B420;
-    if(DevEdidReg.MaxCharRate >= 600)
+    if(DevEdidReg->MaxCharRate >= 600)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_6G;
-    if(DevEdidReg.MaxCharRate >= 450)
+    if(DevEdidReg->MaxCharRate >= 450)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_4G5;
-    if(DevEdidReg.MaxCharRate >= 370)
+    if(DevEdidReg->MaxCharRate >= 370)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_3G75;
-    if(DevEdidReg.MaxTmdsClk >= 300)
+    if(DevEdidReg->MaxTmdsClk >= 300)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_3G;
-    if(DevEdidReg.MaxTmdsClk >= 225)
+    if(DevEdidReg->MaxTmdsClk >= 225)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_2G25;
-    if((DevEdidReg.HdrStCheck[0] != 0) ||
-       (DevEdidReg.HdrStCheck[1] != 0) ||
-       (DevEdidReg.HdrStCheck[2] != 0) ||
-       (DevEdidReg.HdrStCheck[3] != 0))
+    if((DevEdidReg->HdrStCheck[0] != 0) ||
+       (DevEdidReg->HdrStCheck[1] != 0) ||
+       (DevEdidReg->HdrStCheck[2] != 0) ||
+       (DevEdidReg->HdrStCheck[3] != 0))
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_HDR;
-    if(DevEdidReg.Y420VdbCheck[0] == 1)
+    if(DevEdidReg->Y420VdbCheck[0] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_4K50_420;
-    if(DevEdidReg.Y420VdbCheck[1] == 1)
+    if(DevEdidReg->Y420VdbCheck[1] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_4K60_420;
-    if(DevEdidReg.Y420VdbCheck[2] == 1)
+    if(DevEdidReg->Y420VdbCheck[2] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_4KS50_420;
-    if(DevEdidReg.Y420VdbCheck[3] == 1)
+    if(DevEdidReg->Y420VdbCheck[3] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_4KS60_420;
-    if(DevEdidReg.CdbCheck[0] == 1)
+    if(DevEdidReg->CdbCheck[0] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_YUV_601;
-    if(DevEdidReg.CdbCheck[1] == 1)
+    if(DevEdidReg->CdbCheck[1] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_YUV_709;
-    if((DevEdidReg.CdbCheck[5] == 1) || (DevEdidReg.CdbCheck[6] == 1))
+    if((DevEdidReg->CdbCheck[5] == 1) || (DevEdidReg->CdbCheck[6] == 1))
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_YCC_2020;
-    if(DevEdidReg.CdbCheck[7] == 1)
+    if(DevEdidReg->CdbCheck[7] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_RGB_2020;
-    if(DevEdidReg.VcdbCheck[0] == 1)
+    if(DevEdidReg->VcdbCheck[0] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_YUV_FULL_RANGE;
-    if(DevEdidReg.VcdbCheck[1] == 1)
+    if(DevEdidReg->VcdbCheck[1] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_RGB_FULL_RANGE;
-    if(DevEdidReg.VsdbCheckList[11] == 1)
+    if(DevEdidReg->VsdbCheckList[11] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_10B_DEEP_COLOR;
-    if(DevEdidReg.VsdbCheckList[10] == 1)
+    if(DevEdidReg->VsdbCheckList[10] == 1)
         port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_12B_DEEP_COLOR;
     for(i=1;i<14;i++)
     {
-        if(DevEdidReg.EdidCeaAudioCheck[i] == 1)
+        if(DevEdidReg->EdidCeaAudioCheck[i] == 1)
         {
             port->content.tx->EdidSupportFeature = port->content.tx->EdidSupportFeature | AV_BIT_FEAT_COMPRESS_AUDIO;
             break;
@@ -5,6 +5,7 @@
 #define Gsv2k11MuxMode             0
 #define Gsv2k11AudioBypass         0
 #define Gsv2kResourceSize          (Gsv2k11ResourceSize)*(GSV2K11)
+#define AvMaxDeviceNumber          4
 #define AvEnableVideoLogicBus      1
 #define AvForceDefaultEdid         0
 #define AvStrictEdidRule           1
@@ -33,10 +34,15 @@
 #define AvKeyDelayThreshold        250
 #define AvIrdaFunctionInput        0
 #define RxHpdDelayExpireThreshold  0
+#define RxHpdLowMinMs              500
 #define RxLockDelayExpireThreshold 1
 #define RxEQDelayExpireThreshold   2
+#define AvEnableEqPresets          1
+#define AvEqPresetEntries          8
 #define TxVideoManageThreshold     5
+#define TxVideoManageMs            2500
 #define TxHdcpManageThreshold      50
+#define TxHdcpManageMs             25000
 #define AvDontCareEdidSpa          1
 #define AvNoLinkageMode            1
 #define AvAllowHpdLowEdidRead      0
@@ -46,9 +52,21 @@
 #define AvEdidStoredInRam          0
 #define AvEdidSameNoAcknowledge    1
 #define AvEdidErrorThreshold       10
+#define AvEdidCacheEntries         4
+#define AvEdidRamShadow            1
+#define AvEdidReadyTimeout         300
+#define AvEnableSinkEdidCache      1
 #define AvEnableHdcp1p4BksvCheck   0
+#define AvEnableKsvIndex           1
 #define AvEnableTxScdcCedCheck     0
 #define AvEnableTxCtsPhySetting    0
+#define AvEnablePortDirtyTracking  1
+#define AvEnableI2cSnapshot        1
+#define AvI2cSnapshotBlocks        5
+#define AvI2cSnapshotSize          64
+#define AvEnablePacketIntGate      1
+#define AvEnableTxPacketCks        1
+#define AvEnableFastResume         1
 #define Gsv2k11LaneCompensation    1
 #define Gsv2k11WeakParallelDrive   1
 #define Gsv2k11I2SBitAlignment     0
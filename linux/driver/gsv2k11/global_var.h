@@ -9,5 +9,4 @@
 extern uchar  DevicePowerStatus;
 extern char   DeviceName[20];
 extern uchar  AudioStatus;
-extern CEC_AUDIO_STATUS Cec_Tx_Audio_Status;
 #endif
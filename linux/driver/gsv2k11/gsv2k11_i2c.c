@@ -4,10 +4,25 @@
 #include <linux/of_platform.h>
 #include <linux/workqueue.h>
 #include <linux/i2c.h>
+#include <linux/regmap.h>
+#include <linux/interrupt.h>
+#include <linux/mutex.h>
+#include <linux/debugfs.h>
+#include <linux/seq_file.h>
 #include <linux/delay.h>
 #include <linux/timer.h>
 #include <linux/notifier.h>
+#include <linux/idr.h>
 #include <linux/gsv2k11_notifier.h>
+#if IS_ENABLED(CONFIG_GSV2K11_V4L2)
+#include <media/v4l2-device.h>
+#include <media/v4l2-dv-timings.h>
+#include <media/v4l2-event.h>
+#include <media/v4l2-subdev.h>
+#endif
+#if IS_ENABLED(CONFIG_GSV2K11_CEC)
+#include <media/cec.h>
+#endif
 
 #include "kapi/kapi.h"  /* this file includes kernal APIs */
 #include "av_uart_cmd.h" /* accept command */
@@ -30,17 +45,74 @@
 #include "uapi/gsv2k11_device.h"
 #endif
 
+#define CREATE_TRACE_POINTS
+#include "gsv2k11_trace.h"
+
 static BLOCKING_NOTIFIER_HEAD(gsv2k11_notifier_head);
+/* asynchronous consumers and the latest mode posted to each of them */
+static LIST_HEAD(gsv2k11_async_list);
+static DEFINE_SPINLOCK(gsv2k11_async_lock);
 
 #define BusConfig 16
 
+/*
+ * FSM tick period: fast while any FSM walks through its tick-counted
+ * transients, doubling up to the idle period once all of them settled.
+ * The idle period is slowed down to a safety net when the INT pin is wired.
+ * Delays the source or sink must see (hpd low pulse, tx video and hdcp
+ * manage) keep a time floor in the package, RxHpdLowMinMs and Tx*ManageMs.
+ */
+#define GSV2K11_FAST_MS		20
+#define GSV2K11_POLL_MS		500
+#define GSV2K11_IRQ_POLL_MS	2000
+
+/*
+ * Resolution switch: the mute GPIO is released as soon as the tx sends the
+ * new timing, but not before the minimum blanking time since the last rx timing
+ * changed, which hides the transient some sinks show while they relock.
+ * A tx that never sends the new timing is unmuted after the maximum
+ * blanking time, and the tick goes back to what the FSMs need.
+ */
+#define GSV2K11_MIN_BLANK_MS	40
+#define GSV2K11_MAX_BLANK_MS	2000
+
+/*
+ * Measured rates wander by a unit or so from tick to tick on a steady input,
+ * changes within these bounds are not reported as a new mode.
+ */
+#define GSV2K11_RATE_JITTER_HZ	1
+#define GSV2K11_TMDS_JITTER_PCT	1
+
+/* register address: map page in the high byte, highest map is the tx hdcp2.2 one */
+#define GSV2K11_MAX_REGISTER	0x72ff
+
+/* FSM transitions kept for debugfs, power of two */
+#define GSV2K11_FSM_HISTORY	128
+
+/* cec rx buffers and tx result are drained this often while the adapter is on */
+#define GSV2K11_CEC_POLL_MS	20
+
+struct gsv2k11_fsm_event {
+	u64 ts;
+	u16 port;
+	u8 fsm;
+	u8 from;
+	u8 to;
+};
+
 extern uint8 EdidHdmi2p0;
 extern uint8 LogicOutputSel;
 
-static struct i2c_client *g_i2c_client = NULL;
+/* the software package core and bsp hooks are shared by every instance */
+static DEFINE_MUTEX(gsv2k11_core_lock);
+static bool gsv2k11_core_ready;
+/* instance number, used as the bus field of all device addresses */
+static DEFINE_IDA(gsv2k11_ida);
 
 struct gsv2k11_data {
 	struct i2c_client *client;
+	struct regmap *regmap;
+	int index;
 
 	struct gpio_desc *reset_gpiod;
 	struct gpio_desc *mute_gpiod;
@@ -50,80 +122,135 @@ struct gsv2k11_data {
 
 	struct timer_list gsv2k11_timer;
 
+	/* serialises the FSM worker against the interrupt thread */
+	struct mutex lock;
+	int irq;
+	unsigned int poll_ms;
+	/* current FSM tick period and whether the FSMs were settled at it */
+	unsigned int tick_ms;
+	uint8 settled;
+	/* decoded AV_BIT_INT_* events waiting to be serviced, per port */
+	uint32 irq_events[9];
+
 	AvDevice devices[1];
 	Gsv2k11Device gsv2k11_0;
 	AvPort gsv2k11Ports[9];
+	/* port contents and chip resources, carved by AvUapiAllocateMemory */
+	uint8 resource[AvGlobalStaticBufferSize];
+	AvEdidWorkspace edid;
 
 	uint8 cur_vic;
+	/* input timing as last published through sysfs and the notifiers */
+	struct gsv2k11_mode mode;
+#if IS_ENABLED(CONFIG_GSV2K11_V4L2)
+	struct v4l2_subdev sd;
+	struct media_pad pad;
+	/* timings set by the capture side, reported by g_dv_timings */
+	struct v4l2_dv_timings dv_timings;
+#endif
+#if IS_ENABLED(CONFIG_GSV2K11_CEC)
+	struct cec_adapter *cec;
+	struct delayed_work cec_work;
+	bool cec_enabled;
+	/* a frame is in the chip, its result is not read back yet */
+	bool cec_tx_busy;
+	/* logical addresses in the chip's 3 slots, kept for resume */
+	u8 cec_log_addr[3];
+	unsigned int cec_log_addrs;
+	/* physical address last handed to the framework, FSM worker only */
+	u16 cec_phys_addr;
+#if AvEnableCecFeature
+	/* frame of the kapi cec fsm waiting to go out through the framework */
+	struct work_struct cec_client_work;
+	struct cec_msg cec_client_msg;
+	bool cec_client_pending;
+#endif
+#endif
+	/* mute held from switch_start until the tx sends the new timing */
+	bool switching;
+	ktime_t switch_start;
+	unsigned int min_blank_ms;
+	/* last rx timing change to unmute time */
+	unsigned int switch_ms;
+	/* resume to video out time, and whether the stable state was restored */
+	bool resuming;
+	ktime_t resume_start;
+	unsigned int resume_ms;
+	uint8 restored;
+	/*
+	 * last FSM transitions: written by the FSM tick under lock, read
+	 * without it by debugfs, which drops the entries overwritten meanwhile
+	 */
+	struct gsv2k11_fsm_event fsm_history[GSV2K11_FSM_HISTORY];
+	unsigned int fsm_head;
 
 	bool debug;
+	struct dentry *debugfs;
 };
 
-static AvRet gsv2k11_I2cRead(uint32 devAddress, uint32 regAddress, uint8 *data, uint16 count)
+static bool gsv2k11_volatile_reg(struct device *dev, unsigned int reg)
 {
-	AvRet ret = AvOk;
-	uint8 *rd_buf = NULL;
-	uint8 addr_buf[2] = {0};
-	struct i2c_msg msgs[2] = {
-		{
-			.addr	= g_i2c_client->addr,
-			.flags	= 0,
-			.len	= 2,
-			.buf	= addr_buf,
-		},
-		{
-			.addr	= g_i2c_client->addr,
-			.flags	= I2C_M_RD,
-			.len	= count,
-		},
-	};
+	struct gsv2k11_data *gsv2k11 = dev_get_drvdata(dev);
 
-	regAddress = (uint32)((AvGetRegAddress(devAddress) << 8) | AvGetRegAddress(regAddress));
-	addr_buf[0] = (regAddress >> 8) & 0xff;
-	addr_buf[1] = regAddress & 0xff;
+	return AvApiRegisterVolatile(&gsv2k11->devices[0], reg);
+}
+
+/* fifo and packet ram maps, kept out of the regmap debugfs dump */
+static bool gsv2k11_precious_reg(struct device *dev, unsigned int reg)
+{
+	struct gsv2k11_data *gsv2k11 = dev_get_drvdata(dev);
+
+	return AvApiRegisterPrecious(&gsv2k11->devices[0], reg);
+}
 
-	rd_buf = kmalloc(count, GFP_KERNEL);
-	if (rd_buf == NULL)
-		return  -ENOMEM;
+/*
+ * All maps sit behind the one i2c address, the page is sent as the high
+ * register address byte. Written configuration is cached so that resume
+ * can put it back with regcache_sync(), this is the only register cache.
+ */
+static const struct regmap_config gsv2k11_regmap_config = {
+	.name = "gsv2k11",
+	.reg_bits = 16,
+	.val_bits = 8,
+	.max_register = GSV2K11_MAX_REGISTER,
+	.volatile_reg = gsv2k11_volatile_reg,
+	.precious_reg = gsv2k11_precious_reg,
+	.cache_type = REGCACHE_RBTREE,
+};
 
-	msgs[1].buf = rd_buf;
+static AvRet gsv2k11_I2cRead(void *context, uint32 devAddress, uint32 regAddress, uint8 *data, uint16 count)
+{
+	struct gsv2k11_data *gsv2k11 = context;
+	unsigned int reg;
+	int ret;
 
-	ret = i2c_transfer(g_i2c_client->adapter, msgs, 2);
-	if (ret < 0) {
-		dev_err(&g_i2c_client->dev, "i2c read error: %d\n", ret);
-		ret = AvError;
-	} else
-		ret = AvOk;
+	reg = (AvGetRegAddress(devAddress) << 8) | AvGetRegAddress(regAddress);
 
-	if (data != NULL)
-		memcpy(data, rd_buf, count);
-	kfree(rd_buf);
+	/* status bursts are volatile as a whole and stay one transfer */
+	ret = regmap_raw_read(gsv2k11->regmap, reg, data, count);
+	if (ret) {
+		dev_err(&gsv2k11->client->dev, "i2c read error: %d\n", ret);
+		return AvError;
+	}
 
-	return ret;
+	return AvOk;
 }
 
-static AvRet gsv2k11_I2cWrite(uint32 devAddress, uint32 regAddress, uint8 *data, uint16 count)
+static AvRet gsv2k11_I2cWrite(void *context, uint32 devAddress, uint32 regAddress, uint8 *data, uint16 count)
 {
-	AvRet ret = AvOk;
-	uint8 *wr_buf = NULL;
-	wr_buf = kmalloc(count + 2, GFP_KERNEL);
-	if (wr_buf == NULL)
-		return -ENOMEM;
+	struct gsv2k11_data *gsv2k11 = context;
+	unsigned int reg;
+	int ret;
 
-	regAddress = (uint32)((AvGetRegAddress(devAddress) << 8) | AvGetRegAddress(regAddress));
-	wr_buf[0] = (regAddress >> 8) & 0xff;
-	wr_buf[1] = regAddress & 0xff;
-	memcpy(&wr_buf[2], data, count);
+	reg = (AvGetRegAddress(devAddress) << 8) | AvGetRegAddress(regAddress);
 
-	ret = i2c_master_send(g_i2c_client, wr_buf, count + 2);
-	if (ret < 0) {
-		dev_err(&g_i2c_client->dev, "i2c master send error, ret = %d\n", ret);
-		ret = AvError;
-	} else
-		ret = AvOk;
-	kfree(wr_buf);
+	ret = regmap_raw_write(gsv2k11->regmap, reg, data, count);
+	if (ret) {
+		dev_err(&gsv2k11->client->dev, "i2c master send error, ret = %d\n", ret);
+		return AvError;
+	}
 
-	return ret;
+	return AvOk;
 }
 
 static AvRet gsv2k11_GetMilliSecond(uint32 *ms)
@@ -134,6 +261,14 @@ static AvRet gsv2k11_GetMilliSecond(uint32 *ms)
 
 	return ret;
 }
+
+/* hardware waits of the software package, called with the instance lock held */
+static AvRet gsv2k11_SleepMilliSecond(uint32 ms)
+{
+	usleep_range(ms * USEC_PER_MSEC, ms * USEC_PER_MSEC + 500);
+
+	return AvOk;
+}
 /* 1: mute, 0: unmute */
 static void  gsv2k11_mute(struct i2c_client *client, bool mute)
 {
@@ -155,16 +290,852 @@ static void gsv2k11_reset(struct i2c_client *client)
 	mdelay(10);
 }
 
+#if IS_ENABLED(CONFIG_GSV2K11_CEC)
+/*
+ * The cec engine sits behind the tx. Its results are read under the lock,
+ * then handed to the framework after dropping it: the framework calls the
+ * adapter ops with its own lock held, and those take ours.
+ */
+struct gsv2k11_cec_events {
+	struct cec_msg rx[3];
+	unsigned int rx_count;
+	bool tx_done;
+	uint8 tx_status;
+	uint8 nack_cnt;
+	uint8 low_drive_cnt;
+};
+
+static AvPort *gsv2k11_cec_port(struct gsv2k11_data *gsv2k11)
+{
+	return &gsv2k11->gsv2k11Ports[1];
+}
+
+/*
+ * Called with gsv2k11->lock held. The tx result interrupt is read back
+ * even when no frame is outstanding, a stale one would keep firing.
+ */
+static void gsv2k11_cec_collect(struct gsv2k11_data *gsv2k11,
+				struct gsv2k11_cec_events *ev, bool irq)
+{
+	AvPort *port = gsv2k11_cec_port(gsv2k11);
+	struct cec_msg *msg;
+	uint8 buf[17];
+	uint8 len = 0;
+
+	while (gsv2k11->cec_enabled && ev->rx_count < ARRAY_SIZE(ev->rx) &&
+	       AvApiCecReceive(port, buf, &len) == AvOk) {
+		if (len == 0 || len > CEC_MAX_MSG_SIZE)
+			continue;
+		msg = &ev->rx[ev->rx_count++];
+		memset(msg, 0, sizeof(*msg));
+		memcpy(msg->msg, buf, len);
+		msg->len = len;
+	}
+
+	if (!gsv2k11->cec_tx_busy && !irq)
+		return;
+	AvApiCecGetTxStatus(port, &ev->tx_status, &ev->nack_cnt,
+			    &ev->low_drive_cnt);
+	if (ev->tx_status && gsv2k11->cec_tx_busy) {
+		gsv2k11->cec_tx_busy = false;
+		ev->tx_done = true;
+	}
+}
+
+static void gsv2k11_cec_deliver(struct gsv2k11_data *gsv2k11,
+				struct gsv2k11_cec_events *ev)
+{
+	u8 status = CEC_TX_STATUS_MAX_RETRIES;
+	u8 error_cnt = 0;
+	unsigned int i;
+
+	for (i = 0; i < ev->rx_count; i++)
+		cec_received_msg(gsv2k11->cec, &ev->rx[i]);
+
+	if (!ev->tx_done)
+		return;
+	if (ev->tx_status & AV_BIT_CEC_TX_READY) {
+		cec_transmit_attempt_done(gsv2k11->cec, CEC_TX_STATUS_OK);
+		return;
+	}
+	if (ev->tx_status & AV_BIT_CEC_TX_ARB_LOST) {
+		cec_transmit_attempt_done(gsv2k11->cec, CEC_TX_STATUS_ARB_LOST);
+		return;
+	}
+	/* the chip retried by itself and gave up */
+	if (ev->nack_cnt)
+		status |= CEC_TX_STATUS_NACK;
+	if (ev->low_drive_cnt)
+		status |= CEC_TX_STATUS_LOW_DRIVE;
+	if (!ev->nack_cnt && !ev->low_drive_cnt) {
+		status |= CEC_TX_STATUS_ERROR;
+		error_cnt = 1;
+	}
+	cec_transmit_done(gsv2k11->cec, status, 0, ev->nack_cnt,
+			  ev->low_drive_cnt, error_cnt);
+}
+
+static void gsv2k11_cec_client_received(struct gsv2k11_data *gsv2k11,
+					struct gsv2k11_cec_events *ev);
+
+static void gsv2k11_cec_service(struct gsv2k11_data *gsv2k11, bool irq)
+{
+	struct gsv2k11_cec_events ev = { };
+
+	mutex_lock(&gsv2k11->lock);
+	if (gsv2k11->cec_enabled || irq)
+		gsv2k11_cec_collect(gsv2k11, &ev, irq);
+	gsv2k11_cec_client_received(gsv2k11, &ev);
+	mutex_unlock(&gsv2k11->lock);
+
+	gsv2k11_cec_deliver(gsv2k11, &ev);
+}
+
+/* there is no cec rx interrupt source, received frames are polled for */
+static void gsv2k11_cec_work(struct work_struct *work)
+{
+	struct gsv2k11_data *gsv2k11 = container_of(to_delayed_work(work),
+		struct gsv2k11_data, cec_work);
+
+	gsv2k11_cec_service(gsv2k11, false);
+	if (READ_ONCE(gsv2k11->cec_enabled))
+		queue_delayed_work(gsv2k11->gsv2k11_wq, &gsv2k11->cec_work,
+				   msecs_to_jiffies(GSV2K11_CEC_POLL_MS));
+}
+
+static int gsv2k11_cec_adap_enable(struct cec_adapter *adap, bool enable)
+{
+	struct gsv2k11_data *gsv2k11 = cec_get_drvdata(adap);
+	AvPort *port = gsv2k11_cec_port(gsv2k11);
+	int i;
+
+	mutex_lock(&gsv2k11->lock);
+	AvApiCecEnable(port, enable);
+	for (i = 0; i < 3; i++)
+		AvApiCecSetLogAddr(port, i, CEC_LOG_ADDR_INVALID);
+	gsv2k11->cec_log_addrs = 0;
+	gsv2k11->cec_tx_busy = false;
+	WRITE_ONCE(gsv2k11->cec_enabled, enable);
+	mutex_unlock(&gsv2k11->lock);
+
+	/* a disabled adapter lets the poll work run out by itself */
+	if (enable)
+		mod_delayed_work(gsv2k11->gsv2k11_wq, &gsv2k11->cec_work, 0);
+
+	return 0;
+}
+
+static int gsv2k11_cec_adap_log_addr(struct cec_adapter *adap, u8 logical_addr)
+{
+	struct gsv2k11_data *gsv2k11 = cec_get_drvdata(adap);
+	AvPort *port = gsv2k11_cec_port(gsv2k11);
+	int ret = 0;
+	int i;
+
+	mutex_lock(&gsv2k11->lock);
+	if (logical_addr == CEC_LOG_ADDR_INVALID) {
+		for (i = 0; i < 3; i++)
+			AvApiCecSetLogAddr(port, i, CEC_LOG_ADDR_INVALID);
+		gsv2k11->cec_log_addrs = 0;
+	} else if (gsv2k11->cec_log_addrs < 3) {
+		gsv2k11->cec_log_addr[gsv2k11->cec_log_addrs] = logical_addr;
+		AvApiCecSetLogAddr(port, gsv2k11->cec_log_addrs++, logical_addr);
+	} else {
+		ret = -ENXIO;
+	}
+	mutex_unlock(&gsv2k11->lock);
+
+	return ret;
+}
+
+static int gsv2k11_cec_adap_transmit(struct cec_adapter *adap, u8 attempts,
+				     u32 signal_free_time, struct cec_msg *msg)
+{
+	struct gsv2k11_data *gsv2k11 = cec_get_drvdata(adap);
+	AvRet ret;
+
+	/* the chip handles the signal free time itself */
+	mutex_lock(&gsv2k11->lock);
+	ret = AvApiCecTransmit(gsv2k11_cec_port(gsv2k11), msg->msg, msg->len,
+			       attempts ? attempts - 1 : 0);
+	gsv2k11->cec_tx_busy = ret == AvOk;
+	mutex_unlock(&gsv2k11->lock);
+
+	return ret == AvOk ? 0 : -EINVAL;
+}
+
+static const struct cec_adap_ops gsv2k11_cec_ops = {
+	.adap_enable = gsv2k11_cec_adap_enable,
+	.adap_log_addr = gsv2k11_cec_adap_log_addr,
+	.adap_transmit = gsv2k11_cec_adap_transmit,
+};
+
+/* called by the FSM worker without the lock */
+static void gsv2k11_cec_phys_addr(struct gsv2k11_data *gsv2k11, u16 phys_addr)
+{
+	if (phys_addr == gsv2k11->cec_phys_addr)
+		return;
+	gsv2k11->cec_phys_addr = phys_addr;
+	if (phys_addr == CEC_PHYS_ADDR_INVALID)
+		cec_phys_addr_invalidate(gsv2k11->cec);
+	else
+		cec_s_phys_addr(gsv2k11->cec, phys_addr, false);
+}
+
+#if AvEnableCecFeature
+/*
+ * The kapi cec fsm (ARC, system audio) runs as a client of the adapter.
+ * Like the chip's single tx buffer, a newer frame replaces one not yet sent.
+ */
+static AvRet gsv2k11_cec_client_transmit(AvPort *port)
+{
+	struct gsv2k11_data *gsv2k11 = port->device->context;
+	struct cec_msg *msg = &gsv2k11->cec_client_msg;
+
+	if (port->content.cec->TxLen == 0 ||
+	    port->content.cec->TxLen > CEC_MAX_MSG_SIZE)
+		return AvInvalidParameter;
+	memset(msg, 0, sizeof(*msg));
+	msg->len = port->content.cec->TxLen;
+	memcpy(msg->msg, port->content.cec->TxContent, msg->len);
+	gsv2k11->cec_client_pending = true;
+	schedule_work(&gsv2k11->cec_client_work);
+
+	return AvOk;
+}
+
+static void gsv2k11_cec_client_work(struct work_struct *work)
+{
+	struct gsv2k11_data *gsv2k11 = container_of(work, struct gsv2k11_data,
+						    cec_client_work);
+	AvPort *port = gsv2k11_cec_port(gsv2k11);
+	struct cec_msg msg;
+	uint8 status = AV_BIT_CEC_TX_TIMEOUT;
+	uint8 nack_cnt = 0;
+
+	mutex_lock(&gsv2k11->lock);
+	if (!gsv2k11->cec_client_pending) {
+		mutex_unlock(&gsv2k11->lock);
+		return;
+	}
+	msg = gsv2k11->cec_client_msg;
+	gsv2k11->cec_client_pending = false;
+	mutex_unlock(&gsv2k11->lock);
+
+	if (!cec_transmit_msg(gsv2k11->cec, &msg, true)) {
+		if (msg.tx_status & CEC_TX_STATUS_OK)
+			status = AV_BIT_CEC_TX_READY;
+		/* the fsm takes 4 nacks as a free logical address */
+		else if (msg.tx_status & CEC_TX_STATUS_NACK)
+			nack_cnt = 3 + 1;
+	}
+
+	mutex_lock(&gsv2k11->lock);
+	/* a newer frame is queued, its result is the one the fsm waits for */
+	if (!gsv2k11->cec_client_pending)
+		AvApiCecTransmitted(port, status, nack_cnt);
+	mutex_unlock(&gsv2k11->lock);
+}
+
+/* called with gsv2k11->lock held, the fsm sees what the framework sees */
+static void gsv2k11_cec_client_received(struct gsv2k11_data *gsv2k11,
+					struct gsv2k11_cec_events *ev)
+{
+	unsigned int i;
+
+	for (i = 0; i < ev->rx_count; i++)
+		AvApiCecReceived(gsv2k11_cec_port(gsv2k11), ev->rx[i].msg,
+				 ev->rx[i].len);
+}
+#else
+static inline void gsv2k11_cec_client_received(struct gsv2k11_data *gsv2k11,
+					       struct gsv2k11_cec_events *ev) {}
+#endif
+
+static int gsv2k11_cec_init(struct gsv2k11_data *gsv2k11)
+{
+	struct device *dev = &gsv2k11->client->dev;
+	int ret;
+
+	gsv2k11->cec_phys_addr = CEC_PHYS_ADDR_INVALID;
+	INIT_DELAYED_WORK(&gsv2k11->cec_work, gsv2k11_cec_work);
+	gsv2k11->cec = cec_allocate_adapter(&gsv2k11_cec_ops, gsv2k11,
+					    dev_name(dev), CEC_CAP_DEFAULTS, 3);
+	if (IS_ERR(gsv2k11->cec))
+		return PTR_ERR(gsv2k11->cec);
+
+	ret = cec_register_adapter(gsv2k11->cec, dev);
+	if (ret) {
+		cec_delete_adapter(gsv2k11->cec);
+		return ret;
+	}
+
+#if AvEnableCecFeature
+	INIT_WORK(&gsv2k11->cec_client_work, gsv2k11_cec_client_work);
+	/* the transport hook is shared, the fsm clients use their own device */
+	mutex_lock(&gsv2k11_core_lock);
+	AvApiHookCecTransport(&gsv2k11_cec_client_transmit);
+	mutex_unlock(&gsv2k11_core_lock);
+#endif
+
+	return 0;
+}
+
+/* the FSM worker must be stopped, it is what queues client frames */
+static void gsv2k11_cec_exit(struct gsv2k11_data *gsv2k11)
+{
+#if AvEnableCecFeature
+	cancel_work_sync(&gsv2k11->cec_client_work);
+#endif
+	cancel_delayed_work_sync(&gsv2k11->cec_work);
+	cec_unregister_adapter(gsv2k11->cec);
+}
+
+static void gsv2k11_cec_suspend(struct gsv2k11_data *gsv2k11)
+{
+	cancel_delayed_work_sync(&gsv2k11->cec_work);
+}
+
+/* called with gsv2k11->lock held, the cec map is not cached */
+static void gsv2k11_cec_resume(struct gsv2k11_data *gsv2k11)
+{
+	AvPort *port = gsv2k11_cec_port(gsv2k11);
+	unsigned int i;
+
+	if (!gsv2k11->cec_enabled)
+		return;
+	AvApiCecEnable(port, 1);
+	for (i = 0; i < gsv2k11->cec_log_addrs; i++)
+		AvApiCecSetLogAddr(port, i, gsv2k11->cec_log_addr[i]);
+	gsv2k11->cec_tx_busy = false;
+	queue_delayed_work(gsv2k11->gsv2k11_wq, &gsv2k11->cec_work, 0);
+}
+#else
+static inline void gsv2k11_cec_service(struct gsv2k11_data *gsv2k11, bool irq) {}
+static inline void gsv2k11_cec_phys_addr(struct gsv2k11_data *gsv2k11, u16 phys_addr) {}
+static inline int gsv2k11_cec_init(struct gsv2k11_data *gsv2k11) { return 0; }
+static inline void gsv2k11_cec_exit(struct gsv2k11_data *gsv2k11) {}
+static inline void gsv2k11_cec_suspend(struct gsv2k11_data *gsv2k11) {}
+static inline void gsv2k11_cec_resume(struct gsv2k11_data *gsv2k11) {}
+#endif
+
+/* update a port once per pass, bit n of serviced is gsv2k11Ports[n] */
+static void gsv2k11_irq_update(struct gsv2k11_data *gsv2k11, AvPort *port,
+			       u32 *serviced)
+{
+	u32 bit = BIT(port - gsv2k11->gsv2k11Ports);
+
+	if (*serviced & bit)
+		return;
+	*serviced |= bit;
+	AvApiUpdatePort(port);
+}
+
+/*
+ * Update the ports whose interrupt sources fired, together with the ports
+ * they route to, then rearm the sources. Returns the ports updated, the
+ * tick pass skips them.
+ */
+static u32 gsv2k11_irq_service(struct gsv2k11_data *gsv2k11)
+{
+	AvPort *port;
+	u32 serviced = 0;
+	uint32 events;
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(gsv2k11->gsv2k11Ports); i++) {
+		events = gsv2k11->irq_events[i];
+		if (!events)
+			continue;
+
+		gsv2k11->irq_events[i] = 0;
+		port = &gsv2k11->gsv2k11Ports[i];
+
+		gsv2k11_irq_update(gsv2k11, port, &serviced);
+		if (port->content.RouteVideoToPort)
+			gsv2k11_irq_update(gsv2k11,
+				(AvPort *)port->content.RouteVideoToPort, &serviced);
+		if (port->content.RouteAudioToPort)
+			gsv2k11_irq_update(gsv2k11,
+				(AvPort *)port->content.RouteAudioToPort, &serviced);
+
+		AvApiEnableInterrupt(port, events, 1);
+	}
+
+	return serviced;
+}
+
+static irqreturn_t gsv2k11_irq_thread(int irq, void *dev_id)
+{
+	struct gsv2k11_data *gsv2k11 = dev_id;
+	uint32 events;
+	bool pending = false;
+	bool cec = false;
+	int i;
+
+	mutex_lock(&gsv2k11->lock);
+	for (i = 0; i < ARRAY_SIZE(gsv2k11->gsv2k11Ports); i++) {
+		AvApiGetInterrupt(&gsv2k11->gsv2k11Ports[i], &events);
+		/* cec results go straight to the adapter, not through the FSMs */
+		if (IS_ENABLED(CONFIG_GSV2K11_CEC) && (events & AV_BIT_INT_TX_CEC)) {
+			events &= ~AV_BIT_INT_TX_CEC;
+			cec = true;
+		}
+		if (events) {
+			gsv2k11->irq_events[i] |= events;
+			pending = true;
+		}
+	}
+	mutex_unlock(&gsv2k11->lock);
+
+	if (cec)
+		gsv2k11_cec_service(gsv2k11, true);
+
+	if (!pending)
+		return cec ? IRQ_HANDLED : IRQ_NONE;
+
+	mod_delayed_work(gsv2k11->gsv2k11_wq, &gsv2k11->gsv2k11_delayed_work, 0);
+
+	return IRQ_HANDLED;
+}
+
+static void gsv2k11_async_work(struct work_struct *work)
+{
+	struct gsv2k11_async_nb *anb = container_of(work, struct gsv2k11_async_nb, work);
+	struct gsv2k11_mode mode;
+	unsigned int i;
+
+	for (;;) {
+		spin_lock(&gsv2k11_async_lock);
+		if (!anb->pending) {
+			spin_unlock(&gsv2k11_async_lock);
+			break;
+		}
+		i = __ffs(anb->pending);
+		__clear_bit(i, &anb->pending);
+		mode = anb->mode[i];
+		anb->delivered++;
+		spin_unlock(&gsv2k11_async_lock);
+
+		anb->nb.notifier_call(&anb->nb, mode.vic, &mode);
+	}
+}
+
+/* padding is cleared as well, modes are compared with memcmp */
+static void gsv2k11_fill_mode(struct gsv2k11_data *gsv2k11, AvPort *port,
+			      struct gsv2k11_mode *mode)
+{
+	memset(mode, 0, sizeof(*mode));
+	mode->dev		= &gsv2k11->client->dev;
+	mode->vic		= port->content.video->timing.Vic;
+	mode->interlaced	= port->content.video->timing.Interlaced;
+	mode->hpolarity		= port->content.video->timing.HPolarity;
+	mode->vpolarity		= port->content.video->timing.VPolarity;
+	mode->hactive		= port->content.video->timing.HActive;
+	mode->vactive		= port->content.video->timing.VActive;
+	mode->htotal		= port->content.video->timing.HTotal;
+	mode->vtotal		= port->content.video->timing.VTotal;
+	mode->hsync		= port->content.video->timing.HSync;
+	mode->hback		= port->content.video->timing.HBack;
+	mode->vsync		= port->content.video->timing.VSync;
+	mode->vback		= port->content.video->timing.VBack;
+	mode->frame_rate	= port->content.video->timing.FrameRate;
+	mode->tmds_freq		= port->content.video->info.TmdsFreq;
+	mode->colorspace	= port->content.video->Y;
+}
+
+/*
+ * Compare a fresh mode with the published one, the measured frame rate and
+ * tmds frequency only count when they moved by more than their jitter.
+ */
+static bool gsv2k11_mode_changed(const struct gsv2k11_mode *old,
+				 const struct gsv2k11_mode *mode)
+{
+	struct gsv2k11_mode cmp = *mode;
+	unsigned int tmds_jitter = max_t(unsigned int, 1,
+		old->tmds_freq * GSV2K11_TMDS_JITTER_PCT / 100);
+
+	if (abs((int)mode->frame_rate - (int)old->frame_rate) <= GSV2K11_RATE_JITTER_HZ)
+		cmp.frame_rate = old->frame_rate;
+	if (abs((int)mode->tmds_freq - (int)old->tmds_freq) <= tmds_jitter)
+		cmp.tmds_freq = old->tmds_freq;
+
+	return memcmp(&cmp, old, sizeof(cmp)) != 0;
+}
+
+#define GSV2K11_MODE_NOTIFY(kobj, old, new, field)			\
+	do {								\
+		if ((old)->field != (new)->field)			\
+			sysfs_notify(kobj, "timing", #field);		\
+	} while (0)
+
+/*
+ * Publish a changed input timing: pollers of the timing/ attributes that
+ * changed are woken up and a KOBJ_CHANGE uevent carries the new mode.
+ */
+static void gsv2k11_publish_mode(struct gsv2k11_data *gsv2k11,
+				 struct gsv2k11_mode *mode)
+{
+	struct kobject *kobj = &gsv2k11->client->dev.kobj;
+	struct gsv2k11_mode old = gsv2k11->mode;
+	char vic[16], active[32], total[32], rate[24], tmds[24], cs[24];
+	char *envp[] = { vic, active, total, rate, tmds, cs, NULL };
+
+	gsv2k11->mode = *mode;
+
+	GSV2K11_MODE_NOTIFY(kobj, &old, mode, vic);
+	GSV2K11_MODE_NOTIFY(kobj, &old, mode, hactive);
+	GSV2K11_MODE_NOTIFY(kobj, &old, mode, vactive);
+	GSV2K11_MODE_NOTIFY(kobj, &old, mode, htotal);
+	GSV2K11_MODE_NOTIFY(kobj, &old, mode, vtotal);
+	GSV2K11_MODE_NOTIFY(kobj, &old, mode, frame_rate);
+	GSV2K11_MODE_NOTIFY(kobj, &old, mode, interlaced);
+	GSV2K11_MODE_NOTIFY(kobj, &old, mode, colorspace);
+	GSV2K11_MODE_NOTIFY(kobj, &old, mode, tmds_freq);
+
+	snprintf(vic, sizeof(vic), "GSV2K11_VIC=%u", mode->vic);
+	snprintf(active, sizeof(active), "GSV2K11_ACTIVE=%ux%u%s",
+		 mode->hactive, mode->vactive, mode->interlaced ? "i" : "p");
+	snprintf(total, sizeof(total), "GSV2K11_TOTAL=%ux%u",
+		 mode->htotal, mode->vtotal);
+	snprintf(rate, sizeof(rate), "GSV2K11_FRAME_RATE=%u", mode->frame_rate);
+	snprintf(tmds, sizeof(tmds), "GSV2K11_TMDS_FREQ=%u", mode->tmds_freq);
+	snprintf(cs, sizeof(cs), "GSV2K11_COLORSPACE=%u", mode->colorspace);
+	kobject_uevent_env(kobj, KOBJ_CHANGE, envp);
+
+	if (gsv2k11->debug)
+		dev_info(&gsv2k11->client->dev,
+			 "Vic %u %ux%u%s@%u total %ux%u sync %u/%u back %u/%u pol %u/%u tmds %u cs %u\n",
+			 mode->vic, mode->hactive, mode->vactive,
+			 mode->interlaced ? "i" : "p", mode->frame_rate,
+			 mode->htotal, mode->vtotal, mode->hsync, mode->vsync,
+			 mode->hback, mode->vback, mode->hpolarity, mode->vpolarity,
+			 mode->tmds_freq, mode->colorspace);
+}
+
+/*
+ * Report a mode change: synchronous consumers are called in place, the
+ * asynchronous ones get the mode posted in the slot of this instance and
+ * their work queued. A work that is still pending picks up the newer mode
+ * of an instance, so bursts are coalesced per instance.
+ * Called without gsv2k11->lock, a consumer may call back into the driver.
+ */
+static void gsv2k11_notify_mode(struct gsv2k11_data *gsv2k11,
+				struct gsv2k11_mode *mode)
+{
+	struct gsv2k11_async_nb *anb;
+
+	blocking_notifier_call_chain(&gsv2k11_notifier_head, mode->vic, mode);
+
+	spin_lock(&gsv2k11_async_lock);
+	list_for_each_entry(anb, &gsv2k11_async_list, node) {
+		anb->mode[gsv2k11->index] = *mode;
+		__set_bit(gsv2k11->index, &anb->pending);
+		anb->posted++;
+		queue_work(system_long_wq, &anb->work);
+	}
+	spin_unlock(&gsv2k11_async_lock);
+}
+
+#if IS_ENABLED(CONFIG_GSV2K11_V4L2)
+static const struct v4l2_dv_timings_cap gsv2k11_timings_cap = {
+	.type = V4L2_DV_BT_656_1120,
+	/* keep this initialization for compatibility with GCC < 4.4.6 */
+	.reserved = { 0 },
+	V4L2_INIT_BT_TIMINGS(640, 4096, 480, 2160, 25000000, 600000000,
+			     V4L2_DV_BT_STD_CEA861 | V4L2_DV_BT_STD_DMT,
+			     V4L2_DV_BT_CAP_PROGRESSIVE | V4L2_DV_BT_CAP_INTERLACED)
+};
+
+static inline struct gsv2k11_data *to_gsv2k11(struct v4l2_subdev *sd)
+{
+	return container_of(sd, struct gsv2k11_data, sd);
+}
+
+/*
+ * Detected input timings: the CEA-861 entry of the VIC when there is one,
+ * otherwise built from the measured detail timing.
+ */
+static int gsv2k11_mode_to_dv_timings(const struct gsv2k11_mode *mode,
+				      struct v4l2_dv_timings *timings)
+{
+	struct v4l2_bt_timings *bt = &timings->bt;
+	unsigned int vblank;
+
+	if (mode->vic == 0)
+		return -ENOLINK;
+	if (v4l2_find_dv_timings_cea861_vic(timings, mode->vic))
+		return 0;
+	if (!mode->hactive || !mode->vactive || !mode->htotal || !mode->vtotal)
+		return -ENOLCK;
+
+	memset(timings, 0, sizeof(*timings));
+	timings->type = V4L2_DV_BT_656_1120;
+	bt->width = mode->hactive;
+	bt->height = mode->vactive;
+	bt->interlaced = mode->interlaced ? V4L2_DV_INTERLACED : V4L2_DV_PROGRESSIVE;
+	bt->polarities = (mode->hpolarity ? V4L2_DV_HSYNC_POS_POL : 0) |
+			 (mode->vpolarity ? V4L2_DV_VSYNC_POS_POL : 0);
+	bt->pixelclock = (u64)mode->htotal * mode->vtotal * mode->frame_rate;
+	bt->hsync = mode->hsync;
+	bt->hbackporch = mode->hback;
+	bt->hfrontporch = mode->htotal - mode->hactive - mode->hsync - mode->hback;
+	bt->vsync = mode->vsync;
+	bt->vbackporch = mode->vback;
+	vblank = mode->vtotal - mode->vactive;
+	if (mode->interlaced) {
+		/* vertical sizes are per frame, v4l2 wants them per field */
+		bt->pixelclock /= 2;
+		bt->vfrontporch = vblank / 2 - mode->vsync - mode->vback;
+		bt->il_vsync = mode->vsync;
+		bt->il_vbackporch = mode->vback;
+		bt->il_vfrontporch = vblank - vblank / 2 - mode->vsync - mode->vback;
+	} else {
+		bt->vfrontporch = vblank - mode->vsync - mode->vback;
+	}
+
+	return 0;
+}
+
+static int gsv2k11_g_input_status(struct v4l2_subdev *sd, u32 *status)
+{
+	struct gsv2k11_data *gsv2k11 = to_gsv2k11(sd);
+
+	mutex_lock(&gsv2k11->lock);
+	*status = gsv2k11->mode.vic ? 0 : V4L2_IN_ST_NO_SIGNAL;
+	mutex_unlock(&gsv2k11->lock);
+
+	return 0;
+}
+
+static int gsv2k11_query_dv_timings(struct v4l2_subdev *sd,
+				    struct v4l2_dv_timings *timings)
+{
+	struct gsv2k11_data *gsv2k11 = to_gsv2k11(sd);
+	int ret;
+
+	mutex_lock(&gsv2k11->lock);
+	ret = gsv2k11_mode_to_dv_timings(&gsv2k11->mode, timings);
+	mutex_unlock(&gsv2k11->lock);
+	if (ret)
+		return ret;
+
+	if (!v4l2_valid_dv_timings(timings, &gsv2k11_timings_cap, NULL, NULL))
+		return -ERANGE;
+
+	return 0;
+}
+
+static int gsv2k11_g_dv_timings(struct v4l2_subdev *sd,
+				struct v4l2_dv_timings *timings)
+{
+	struct gsv2k11_data *gsv2k11 = to_gsv2k11(sd);
+
+	mutex_lock(&gsv2k11->lock);
+	*timings = gsv2k11->dv_timings;
+	mutex_unlock(&gsv2k11->lock);
+
+	return 0;
+}
+
+static int gsv2k11_s_dv_timings(struct v4l2_subdev *sd,
+				struct v4l2_dv_timings *timings)
+{
+	struct gsv2k11_data *gsv2k11 = to_gsv2k11(sd);
+
+	if (!v4l2_valid_dv_timings(timings, &gsv2k11_timings_cap, NULL, NULL))
+		return -ERANGE;
+
+	mutex_lock(&gsv2k11->lock);
+	gsv2k11->dv_timings = *timings;
+	mutex_unlock(&gsv2k11->lock);
+
+	return 0;
+}
+
+static int gsv2k11_enum_dv_timings(struct v4l2_subdev *sd,
+				   struct v4l2_enum_dv_timings *timings)
+{
+	if (timings->pad != 0)
+		return -EINVAL;
+
+	return v4l2_enum_dv_timings_cap(timings, &gsv2k11_timings_cap, NULL, NULL);
+}
+
+static int gsv2k11_dv_timings_cap(struct v4l2_subdev *sd,
+				  struct v4l2_dv_timings_cap *cap)
+{
+	if (cap->pad != 0)
+		return -EINVAL;
+
+	*cap = gsv2k11_timings_cap;
+
+	return 0;
+}
+
+static int gsv2k11_subscribe_event(struct v4l2_subdev *sd, struct v4l2_fh *fh,
+				   struct v4l2_event_subscription *sub)
+{
+	switch (sub->type) {
+	case V4L2_EVENT_SOURCE_CHANGE:
+		return v4l2_src_change_event_subdev_subscribe(sd, fh, sub);
+	default:
+		return -EINVAL;
+	}
+}
+
+static const struct v4l2_subdev_core_ops gsv2k11_core_ops = {
+	.subscribe_event = gsv2k11_subscribe_event,
+	.unsubscribe_event = v4l2_event_subdev_unsubscribe,
+};
+
+static const struct v4l2_subdev_video_ops gsv2k11_video_ops = {
+	.g_input_status = gsv2k11_g_input_status,
+	.s_dv_timings = gsv2k11_s_dv_timings,
+	.g_dv_timings = gsv2k11_g_dv_timings,
+	.query_dv_timings = gsv2k11_query_dv_timings,
+};
+
+static const struct v4l2_subdev_pad_ops gsv2k11_pad_ops = {
+	.enum_dv_timings = gsv2k11_enum_dv_timings,
+	.dv_timings_cap = gsv2k11_dv_timings_cap,
+};
+
+static const struct v4l2_subdev_ops gsv2k11_subdev_ops = {
+	.core = &gsv2k11_core_ops,
+	.video = &gsv2k11_video_ops,
+	.pad = &gsv2k11_pad_ops,
+};
+
+static void gsv2k11_v4l2_source_change(struct gsv2k11_data *gsv2k11)
+{
+	static const struct v4l2_event ev = {
+		.type = V4L2_EVENT_SOURCE_CHANGE,
+		.u.src_change.changes = V4L2_EVENT_SRC_CH_RESOLUTION,
+	};
+
+	v4l2_subdev_notify_event(&gsv2k11->sd, &ev);
+}
+
+/*
+ * The subdev is set up by hand instead of v4l2_i2c_subdev_init(), which
+ * would take over the i2c client data the rest of the driver relies on.
+ */
+static int gsv2k11_v4l2_init(struct gsv2k11_data *gsv2k11)
+{
+	struct i2c_client *client = gsv2k11->client;
+	struct v4l2_subdev *sd = &gsv2k11->sd;
+	int ret;
+
+	gsv2k11->dv_timings = (struct v4l2_dv_timings)V4L2_DV_BT_CEA_1920X1080P60;
+
+	v4l2_subdev_init(sd, &gsv2k11_subdev_ops);
+	sd->owner = THIS_MODULE;
+	sd->dev = &client->dev;
+	sd->flags |= V4L2_SUBDEV_FL_HAS_DEVNODE | V4L2_SUBDEV_FL_HAS_EVENTS;
+	v4l2_set_subdevdata(sd, gsv2k11);
+	snprintf(sd->name, sizeof(sd->name), "gsv2k11 %d-%04x",
+		 i2c_adapter_id(client->adapter), client->addr);
+
+	gsv2k11->pad.flags = MEDIA_PAD_FL_SOURCE;
+	sd->entity.function = MEDIA_ENT_F_DV_DECODER;
+	ret = media_entity_pads_init(&sd->entity, 1, &gsv2k11->pad);
+	if (ret)
+		return ret;
+
+	ret = v4l2_async_register_subdev(sd);
+	if (ret)
+		media_entity_cleanup(&sd->entity);
+
+	return ret;
+}
+
+static void gsv2k11_v4l2_exit(struct gsv2k11_data *gsv2k11)
+{
+	v4l2_async_unregister_subdev(&gsv2k11->sd);
+	media_entity_cleanup(&gsv2k11->sd.entity);
+}
+#else
+static inline void gsv2k11_v4l2_source_change(struct gsv2k11_data *gsv2k11) {}
+static inline int gsv2k11_v4l2_init(struct gsv2k11_data *gsv2k11) { return 0; }
+static inline void gsv2k11_v4l2_exit(struct gsv2k11_data *gsv2k11) {}
+#endif
+
+/*
+ * Unmute once the tx sends the new timing and the minimum blanking time has
+ * passed, or anyway once the maximum blanking time has. Returns 0 when
+ * unmuted, otherwise how long to wait before the next check.
+ */
+static unsigned int gsv2k11_switch_unmute(struct gsv2k11_data *gsv2k11)
+{
+	unsigned int min_blank = READ_ONCE(gsv2k11->min_blank_ms);
+	unsigned int elapsed;
+	uint8 ready;
+
+	elapsed = ktime_ms_delta(ktime_get(), gsv2k11->switch_start);
+	AvApiCheckVideoOut(&gsv2k11->devices[0], &ready);
+	if (!ready) {
+		if (elapsed < max_t(unsigned int, GSV2K11_MAX_BLANK_MS, min_blank))
+			return GSV2K11_FAST_MS;
+		dev_warn(&gsv2k11->client->dev,
+			 "Vic %d not sent after %u ms, unmuting\n",
+			 gsv2k11->cur_vic, elapsed);
+	} else if (elapsed < min_blank) {
+		return min_blank - elapsed;
+	}
+
+	gsv2k11_mute(gsv2k11->client, 0);
+	gsv2k11->switching = false;
+	WRITE_ONCE(gsv2k11->switch_ms, elapsed);
+	dev_dbg(&gsv2k11->client->dev, "Vic %d switch took %u ms\n",
+		gsv2k11->cur_vic, elapsed);
+
+	return 0;
+}
+
+static void gsv2k11_resume_done(struct gsv2k11_data *gsv2k11)
+{
+	uint8 ready;
+
+	AvApiCheckVideoOut(&gsv2k11->devices[0], &ready);
+	if (!ready)
+		return;
+
+	gsv2k11->resuming = false;
+	WRITE_ONCE(gsv2k11->resume_ms,
+		   ktime_ms_delta(ktime_get(), gsv2k11->resume_start));
+	dev_dbg(&gsv2k11->client->dev, "resume (%s) took %u ms\n",
+		gsv2k11->restored ? "restored" : "full", gsv2k11->resume_ms);
+}
+
 static void gsv2k11_work(struct work_struct *work)
 {
 	struct gsv2k11_data *gsv2k11 = container_of(to_delayed_work(work),
 		struct gsv2k11_data, gsv2k11_delayed_work);
 	AvPort *port = gsv2k11->devices[0].port;
+	AvPort *tx = &gsv2k11->gsv2k11Ports[1];
+	struct gsv2k11_mode mode;
+	bool notify = false;
+	/* CEC_PHYS_ADDR_INVALID */
+	u16 phys_addr = 0xffff;
+	unsigned int tick_ms;
+	unsigned int wait_ms = 0;
+	u32 serviced;
+	bool tick;
 	uint8 NewVic = 0x61;
 	uint16 PixelFreq = 0;
 	uint8 CommonBusConfig = BusConfig;
 
-	AvApiUpdate();
+	mutex_lock(&gsv2k11->lock);
+
+	/*
+	 * The timer is still armed when the interrupt queued this run, only
+	 * the fired ports are updated then. On the tick the other ports are.
+	 */
+	tick = !timer_pending(&gsv2k11->gsv2k11_timer);
+	serviced = gsv2k11_irq_service(gsv2k11);
+	if (tick)
+		AvApiUpdateExcept(&gsv2k11->devices[0], serviced);
 	AvPortConnectUpdate(&gsv2k11->devices[0]);
 	/* 4.1 switch Vic based on frequency */
 	if((LogicOutputSel == 0) && (gsv2k11->gsv2k11Ports[7].content.lvrx->Lock == 1)) {
@@ -192,37 +1163,55 @@ static void gsv2k11_work(struct work_struct *work)
 		}
 	}
 
-	if (gsv2k11->cur_vic != port->content.video->timing.Vic) {
+	gsv2k11_fill_mode(gsv2k11, port, &mode);
+	/* sysfs, the notifiers and v4l2 all report the same timing changes */
+	if (gsv2k11_mode_changed(&gsv2k11->mode, &mode)) {
+		gsv2k11_publish_mode(gsv2k11, &mode);
+		notify = true;
+		gsv2k11_v4l2_source_change(gsv2k11);
+	}
+
+	if (gsv2k11->cur_vic != mode.vic) {
 		gsv2k11_mute(gsv2k11->client, 1);
-		gsv2k11->cur_vic = port->content.video->timing.Vic;
-		blocking_notifier_call_chain(&gsv2k11_notifier_head, gsv2k11->cur_vic, NULL);
+		/* blanking counts from the last change, so a no signal gap is not included */
+		gsv2k11->switching = true;
+		gsv2k11->switch_start = ktime_get();
+		gsv2k11->cur_vic = mode.vic;
 		dev_info(&gsv2k11->client->dev, "Vic = %d\n", gsv2k11->cur_vic);
-
-		if (port->content.video->timing.Vic != 0) {
-			gsv2k11_mute(gsv2k11->client, 0);
-
-			if (gsv2k11->debug) {
-				dev_info(&gsv2k11->client->dev, "Vic = %d\n", port->content.video->timing.Vic);
-				dev_info(&gsv2k11->client->dev, "HPolarity = %d\n", port->content.video->timing.HPolarity);
-				dev_info(&gsv2k11->client->dev, "VPolarity = %d\n", port->content.video->timing.VPolarity);
-				dev_info(&gsv2k11->client->dev, "Interlaced = %d\n", port->content.video->timing.Interlaced);
-				dev_info(&gsv2k11->client->dev, "HActive = %d\n", port->content.video->timing.HActive);
-				dev_info(&gsv2k11->client->dev, "VActive = %d\n", port->content.video->timing.VActive);
-				dev_info(&gsv2k11->client->dev, "HTotal = %d\n", port->content.video->timing.HTotal);
-				dev_info(&gsv2k11->client->dev, "VTotal = %d\n", port->content.video->timing.VTotal);
-				dev_info(&gsv2k11->client->dev, "FrameRate = %d\n", port->content.video->timing.FrameRate);
-				dev_info(&gsv2k11->client->dev, "VSync = %d\n", port->content.video->timing.VSync);
-				dev_info(&gsv2k11->client->dev, "VSync = %d\n", port->content.video->timing.VBack);
-				dev_info(&gsv2k11->client->dev, "HSync = %d\n", port->content.video->timing.HSync);
-				dev_info(&gsv2k11->client->dev, "HBack = %d\n", port->content.video->timing.HBack);
-			}
-		} else {
-			/* mute */
-			gsv2k11_mute(gsv2k11->client, 1);
-		}
 	}
-
-	mod_timer(&gsv2k11->gsv2k11_timer, jiffies + msecs_to_jiffies(500));
+	if (gsv2k11->switching && gsv2k11->cur_vic != 0)
+		wait_ms = gsv2k11_switch_unmute(gsv2k11);
+	if (gsv2k11->resuming)
+		gsv2k11_resume_done(gsv2k11);
+
+	AvApiCheckSettled(&gsv2k11->devices[0], &gsv2k11->settled);
+	if (!gsv2k11->settled)
+		gsv2k11->tick_ms = GSV2K11_FAST_MS;
+	else if (tick)
+		gsv2k11->tick_ms = min(gsv2k11->tick_ms * 2, gsv2k11->poll_ms);
+	tick_ms = gsv2k11->tick_ms;
+	if (wait_ms)
+		tick_ms = min(tick_ms, wait_ms);
+
+	/* a sink without a cec physical address in its edid has no cec */
+	if (tx->content.tx->Hpd == AV_HPD_HIGH &&
+	    tx->content.tx->EdidReadSuccess == AV_EDID_UPDATED &&
+	    tx->content.tx->PhyAddr != 0)
+		phys_addr = tx->content.tx->PhyAddr;
+
+	mutex_unlock(&gsv2k11->lock);
+
+	/* the work is not reentrant, modes are still reported in order */
+	if (notify)
+		gsv2k11_notify_mode(gsv2k11, &mode);
+
+	gsv2k11_cec_phys_addr(gsv2k11, phys_addr);
+
+	/* an interrupt run may bring the tick forward, never push it back */
+	if (tick)
+		mod_timer(&gsv2k11->gsv2k11_timer, jiffies + msecs_to_jiffies(tick_ms));
+	else
+		timer_reduce(&gsv2k11->gsv2k11_timer, jiffies + msecs_to_jiffies(tick_ms));
 }
 
 static void gsv2k11_timer_handler(struct timer_list *timer)
@@ -286,10 +1275,82 @@ static ssize_t debug_store(struct device *dev, struct device_attribute *attr,
 }
 static DEVICE_ATTR_RW(debug);
 
+static ssize_t fsm_state_show(struct device *dev, struct device_attribute *attr,
+		char *buf)
+{
+	struct i2c_client *client = to_i2c_client(dev);
+	struct gsv2k11_data *data = i2c_get_clientdata(client);
+
+	return sprintf(buf, "%s\n", READ_ONCE(data->settled) ? "settled" : "transient");
+}
+static DEVICE_ATTR_RO(fsm_state);
+
+static ssize_t tick_ms_show(struct device *dev, struct device_attribute *attr,
+		char *buf)
+{
+	struct i2c_client *client = to_i2c_client(dev);
+	struct gsv2k11_data *data = i2c_get_clientdata(client);
+
+	return sprintf(buf, "%u\n", READ_ONCE(data->tick_ms));
+}
+static DEVICE_ATTR_RO(tick_ms);
+
+static ssize_t min_blank_ms_show(struct device *dev, struct device_attribute *attr,
+		char *buf)
+{
+	struct i2c_client *client = to_i2c_client(dev);
+	struct gsv2k11_data *data = i2c_get_clientdata(client);
+
+	return sprintf(buf, "%u\n", READ_ONCE(data->min_blank_ms));
+}
+
+static ssize_t min_blank_ms_store(struct device *dev, struct device_attribute *attr,
+		const char *buf, size_t count)
+{
+	struct i2c_client *client = to_i2c_client(dev);
+	struct gsv2k11_data *data = i2c_get_clientdata(client);
+	unsigned int val;
+	int rc;
+
+	rc = kstrtouint(buf, 0, &val);
+	if (rc)
+		return rc;
+
+	WRITE_ONCE(data->min_blank_ms, val);
+
+	return count;
+}
+static DEVICE_ATTR_RW(min_blank_ms);
+
+static ssize_t switch_ms_show(struct device *dev, struct device_attribute *attr,
+		char *buf)
+{
+	struct i2c_client *client = to_i2c_client(dev);
+	struct gsv2k11_data *data = i2c_get_clientdata(client);
+
+	return sprintf(buf, "%u\n", READ_ONCE(data->switch_ms));
+}
+static DEVICE_ATTR_RO(switch_ms);
+
+static ssize_t resume_ms_show(struct device *dev, struct device_attribute *attr,
+		char *buf)
+{
+	struct i2c_client *client = to_i2c_client(dev);
+	struct gsv2k11_data *data = i2c_get_clientdata(client);
+
+	return sprintf(buf, "%u\n", READ_ONCE(data->resume_ms));
+}
+static DEVICE_ATTR_RO(resume_ms);
+
 /* add your attr in here*/
 static struct attribute *gsv2k11_attributes[] = {
 	&dev_attr_mute.attr,
 	&dev_attr_debug.attr,
+	&dev_attr_fsm_state.attr,
+	&dev_attr_tick_ms.attr,
+	&dev_attr_min_blank_ms.attr,
+	&dev_attr_switch_ms.attr,
+	&dev_attr_resume_ms.attr,
 	NULL
 };
 
@@ -297,11 +1358,184 @@ static struct attribute_group gsv2k11_attribute_group = {
 	.attrs = gsv2k11_attributes
 };
 
+/* input timing, pollable: sysfs_notify() fires when a value changes */
+#define GSV2K11_TIMING_ATTR(field)					\
+static ssize_t field##_show(struct device *dev,				\
+		struct device_attribute *attr, char *buf)		\
+{									\
+	struct i2c_client *client = to_i2c_client(dev);			\
+	struct gsv2k11_data *data = i2c_get_clientdata(client);		\
+	unsigned int val;						\
+									\
+	mutex_lock(&data->lock);					\
+	val = data->mode.field;						\
+	mutex_unlock(&data->lock);					\
+									\
+	return sprintf(buf, "%u\n", val);				\
+}									\
+static DEVICE_ATTR_RO(field)
+
+GSV2K11_TIMING_ATTR(vic);
+GSV2K11_TIMING_ATTR(hactive);
+GSV2K11_TIMING_ATTR(vactive);
+GSV2K11_TIMING_ATTR(htotal);
+GSV2K11_TIMING_ATTR(vtotal);
+GSV2K11_TIMING_ATTR(frame_rate);
+GSV2K11_TIMING_ATTR(interlaced);
+GSV2K11_TIMING_ATTR(tmds_freq);
+
+static ssize_t colorspace_show(struct device *dev, struct device_attribute *attr,
+		char *buf)
+{
+	static const char * const names[] = { "rgb", "yuv422", "yuv444", "yuv420" };
+	struct i2c_client *client = to_i2c_client(dev);
+	struct gsv2k11_data *data = i2c_get_clientdata(client);
+	unsigned int cs;
+
+	mutex_lock(&data->lock);
+	cs = data->mode.colorspace;
+	mutex_unlock(&data->lock);
+
+	if (cs >= ARRAY_SIZE(names))
+		return sprintf(buf, "unknown\n");
+
+	return sprintf(buf, "%s\n", names[cs]);
+}
+static DEVICE_ATTR_RO(colorspace);
+
+static struct attribute *gsv2k11_timing_attributes[] = {
+	&dev_attr_vic.attr,
+	&dev_attr_hactive.attr,
+	&dev_attr_vactive.attr,
+	&dev_attr_htotal.attr,
+	&dev_attr_vtotal.attr,
+	&dev_attr_frame_rate.attr,
+	&dev_attr_interlaced.attr,
+	&dev_attr_colorspace.attr,
+	&dev_attr_tmds_freq.attr,
+	NULL
+};
+
+static struct attribute_group gsv2k11_timing_group = {
+	.name = "timing",
+	.attrs = gsv2k11_timing_attributes
+};
+
+/* port updates done and skipped as clean, diff two reads for a rate */
+static int gsv2k11_ports_show(struct seq_file *s, void *unused)
+{
+	struct gsv2k11_data *gsv2k11 = s->private;
+	AvPort *port;
+	int i;
+
+	mutex_lock(&gsv2k11->lock);
+	seq_printf(s, "generation: %u\n", gsv2k11->devices[0].generation);
+	for (i = 0; i < ARRAY_SIZE(gsv2k11->gsv2k11Ports); i++) {
+		port = &gsv2k11->gsv2k11Ports[i];
+		seq_printf(s, "port%d index %u type %d: serviced %u skipped %u\n",
+			   i, port->index, port->type, port->serviced, port->skipped);
+		if (port->type == HdmiTx)
+			seq_printf(s, "port%d edid wait: last %u ms max %u ms timeouts %u, cached %u\n",
+				   i, port->content.tx->EdidWaitMs,
+				   port->content.tx->EdidWaitMaxMs,
+				   port->content.tx->EdidWaitTimeouts,
+				   port->content.tx->EdidCacheHits);
+#if AvEnableTxPacketCks
+		if (port->type == HdmiTx)
+			seq_printf(s, "port%d packets: forwarded %u suppressed %u\n",
+				   i, port->content.tx->PktForwarded,
+				   port->content.tx->PktSuppressed);
+#endif
+	}
+	mutex_unlock(&gsv2k11->lock);
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(gsv2k11_ports);
+
+static int gsv2k11_notifier_show(struct seq_file *s, void *unused)
+{
+	struct gsv2k11_async_nb *anb;
+
+	spin_lock(&gsv2k11_async_lock);
+	list_for_each_entry(anb, &gsv2k11_async_list, node)
+		seq_printf(s, "%ps: posted %u delivered %u\n",
+			   anb->nb.notifier_call, anb->posted, anb->delivered);
+	spin_unlock(&gsv2k11_async_lock);
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(gsv2k11_notifier);
+
+static int gsv2k11_fsm_history_show(struct seq_file *s, void *unused)
+{
+	struct gsv2k11_data *gsv2k11 = s->private;
+	struct gsv2k11_fsm_event ev;
+	unsigned int head, i;
+	u32 rem;
+	u64 sec;
+
+	head = smp_load_acquire(&gsv2k11->fsm_head);
+	/* the slot at head - GSV2K11_FSM_HISTORY is the next one written */
+	i = head >= GSV2K11_FSM_HISTORY ? head - GSV2K11_FSM_HISTORY + 1 : 0;
+	for (; i != head; i++) {
+		ev = gsv2k11->fsm_history[i & (GSV2K11_FSM_HISTORY - 1)];
+		/* the writer may have lapped this slot while it was copied */
+		smp_rmb();
+		if (READ_ONCE(gsv2k11->fsm_head) - i >= GSV2K11_FSM_HISTORY)
+			continue;
+		sec = div_u64_rem(ev.ts, NSEC_PER_SEC, &rem);
+		seq_printf(s, "[%5llu.%06u] port%u %s: %s -> %s\n",
+			   sec, rem / NSEC_PER_USEC, ev.port,
+			   AvApiFsmName(ev.fsm),
+			   AvApiFsmStateName(ev.fsm, ev.from),
+			   AvApiFsmStateName(ev.fsm, ev.to));
+	}
+
+	return 0;
+}
+DEFINE_SHOW_ATTRIBUTE(gsv2k11_fsm_history);
+
+static void gsv2k11_debugfs_init(struct gsv2k11_data *gsv2k11)
+{
+	gsv2k11->debugfs = debugfs_create_dir(dev_name(&gsv2k11->client->dev), NULL);
+	debugfs_create_file("ports", 0444, gsv2k11->debugfs, gsv2k11,
+			    &gsv2k11_ports_fops);
+	debugfs_create_file("notifier", 0444, gsv2k11->debugfs, gsv2k11,
+			    &gsv2k11_notifier_fops);
+	debugfs_create_file("fsm_history", 0444, gsv2k11->debugfs, gsv2k11,
+			    &gsv2k11_fsm_history_fops);
+}
+
+/* FSM transition hook, called from the FSM tick with the instance lock held */
+static void gsv2k11_fsm_transition(AvPort *port, uint8 Fsm, uint8 OldState, uint8 NewState)
+{
+	struct gsv2k11_data *gsv2k11 = port->device->context;
+	struct gsv2k11_fsm_event *ev;
+	unsigned int head = gsv2k11->fsm_head;
+
+	/* order the previous head update before the slot is overwritten */
+	smp_wmb();
+	ev = &gsv2k11->fsm_history[head & (GSV2K11_FSM_HISTORY - 1)];
+	ev->ts = ktime_get_ns();
+	ev->port = port->index;
+	ev->fsm = Fsm;
+	ev->from = OldState;
+	ev->to = NewState;
+	smp_store_release(&gsv2k11->fsm_head, head + 1);
+
+	if (trace_gsv2k11_fsm_enabled())
+		trace_gsv2k11_fsm(gsv2k11->index, port->index, AvApiFsmName(Fsm),
+				  AvApiFsmStateName(Fsm, OldState),
+				  AvApiFsmStateName(Fsm, NewState));
+}
+
 static int gsv2k11_i2c_check(struct i2c_client *client)
 {
+	struct gsv2k11_data *gsv2k11 = i2c_get_clientdata(client);
 	uint8 ret = 0;
 
-	return gsv2k11_I2cWrite(0, 0, &ret, 1) | gsv2k11_I2cRead(0, 0, &ret, 1);
+	return gsv2k11_I2cWrite(gsv2k11, 0, 0, &ret, 1) | gsv2k11_I2cRead(gsv2k11, 0, 0, &ret, 1);
 }
 
 static int gsv2k11_init(struct i2c_client *client)
@@ -318,23 +1552,35 @@ static int gsv2k11_init(struct i2c_client *client)
 		return ret;
 	}
 
-	/* 1.2 init software package and hookup user's bsp functions */
-	AvApiInit();
-	AvApiHookBspFunctions(&gsv2k11_I2cRead, &gsv2k11_I2cWrite,
-						  NULL, NULL,
-						  &gsv2k11_GetMilliSecond,
-						  NULL, NULL);
-	AvApiHookUserFunctions(&ListenToKeyCommand, &ListenToUartCommand, &ListenToIrdaCommand);
+	/* 1.2 init software package and hookup user's bsp functions, once for all instances */
+	mutex_lock(&gsv2k11_core_lock);
+	if (!gsv2k11_core_ready) {
+		AvApiInit();
+		AvApiHookBspFunctions(&gsv2k11_I2cRead, &gsv2k11_I2cWrite,
+							  NULL, NULL,
+							  &gsv2k11_GetMilliSecond,
+							  NULL, NULL);
+		AvApiHookBspSleep(&gsv2k11_SleepMilliSecond);
+		AvApiHookUserFunctions(&ListenToKeyCommand, &ListenToUartCommand, &ListenToIrdaCommand);
+		AvApiHookFsmTransition(&gsv2k11_fsm_transition);
+		gsv2k11_core_ready = true;
+	}
+	mutex_unlock(&gsv2k11_core_lock);
 
 	/* 2.2 specific devices and ports */
 	/* they must be able to be linked to the device in 1. */
 
 	/* 2.3 init device address in 2.2 */
-	gsv2k11->gsv2k11_0.DeviceAddress = AvGenerateDeviceAddress(0x00, 0x01, client->addr << 1, 0x00);
+	gsv2k11->gsv2k11_0.DeviceAddress = AvGenerateDeviceAddress(gsv2k11->index, 0x01, client->addr << 1, 0x00);
 
-	/* 2.4 connect devices to device declaration */
-	AvApiAddDevice(&gsv2k11->devices[0], Gsv2k11, 0,
+	/* 2.4 connect devices to device declaration, with this instance's bsp context and buffers */
+	gsv2k11->devices[0].context = gsv2k11;
+	gsv2k11->devices[0].buffer  = gsv2k11->resource;
+	gsv2k11->devices[0].edid    = &gsv2k11->edid;
+	ret = AvApiAddDevice(&gsv2k11->devices[0], Gsv2k11, gsv2k11->index,
 		(void *)&gsv2k11->gsv2k11_0, (void *)&gsv2k11->gsv2k11Ports[0],  NULL);
+	if (ret)
+		return -EINVAL;
 
 	/* 3. Port Level Declaration */
 	/* 3.1 init devices and port structure, must declare in number order */
@@ -361,22 +1607,24 @@ static int gsv2k11_init(struct i2c_client *client)
 		gsv2k11->gsv2k11Ports[1].content.cec->EnableAudioAmplifier = AV_CEC_AMP_TO_ENABLE;
 		gsv2k11->gsv2k11Ports[1].content.cec->EnableARC = AV_CEC_ARC_TO_INITIATE;
 	}
-	Cec_Tx_Audio_Status.Volume = 30;
-	Cec_Tx_Audio_Status.Mute   = 0;	/*  */
-	Cec_Tx_Audio_Status.AudioMode = 1; /* Audio Mode is ON to meet ARC */
-	Cec_Tx_Audio_Status.AudioRate = 1; /* 100% rate */
-	Cec_Tx_Audio_Status.AudioFormatCode = AV_AUD_FORMAT_LINEAR_PCM; /* Follow Spec */
-	Cec_Tx_Audio_Status.MaxNumberOfChannels = 2; /* Max Channels */
-	Cec_Tx_Audio_Status.AudioSampleRate = 0x07; /* 32KHz/44.1KHz/48KHz */
-	Cec_Tx_Audio_Status.AudioBitLen = 0x01;  /* 16-bit only */
-	Cec_Tx_Audio_Status.MaxBitRate	= 0;  /* default */
-	Cec_Tx_Audio_Status.ActiveSource = 0; /* default */
+	gsv2k11->gsv2k11Ports[1].content.cec->AudioState.Volume = 30;
+	gsv2k11->gsv2k11Ports[1].content.cec->AudioState.Mute   = 0;	/*  */
+	gsv2k11->gsv2k11Ports[1].content.cec->AudioState.AudioMode = 1; /* Audio Mode is ON to meet ARC */
+	gsv2k11->gsv2k11Ports[1].content.cec->AudioState.AudioRate = 1; /* 100% rate */
+	gsv2k11->gsv2k11Ports[1].content.cec->AudioState.AudioFormatCode = AV_AUD_FORMAT_LINEAR_PCM; /* Follow Spec */
+	gsv2k11->gsv2k11Ports[1].content.cec->AudioState.MaxNumberOfChannels = 2; /* Max Channels */
+	gsv2k11->gsv2k11Ports[1].content.cec->AudioState.AudioSampleRate = 0x07; /* 32KHz/44.1KHz/48KHz */
+	gsv2k11->gsv2k11Ports[1].content.cec->AudioState.AudioBitLen = 0x01;  /* 16-bit only */
+	gsv2k11->gsv2k11Ports[1].content.cec->AudioState.MaxBitRate	= 0;  /* default */
+	gsv2k11->gsv2k11Ports[1].content.cec->AudioState.ActiveSource = 0; /* default */
 #endif
 	/* 3.3 init fsms */
 
+	/* the device init soft resets the chip, forget what the bus check wrote */
+	regcache_drop_region(gsv2k11->regmap, 0, GSV2K11_MAX_REGISTER);
 	AvApiInitDevice(&gsv2k11->devices[0]);
 
-	AvApiPortStart();
+	AvApiPortStart(&gsv2k11->devices[0]);
 
 	/* 3.4 routing */
 	/* connect the port by video using AvConnectVideo */
@@ -491,6 +1739,34 @@ int gsv2k11_notifier_unregister(struct notifier_block *nb)
 }
 EXPORT_SYMBOL(gsv2k11_notifier_unregister);
 
+int gsv2k11_notifier_register_async(struct gsv2k11_async_nb *anb)
+{
+	BUILD_BUG_ON(AvMaxDeviceNumber > GSV2K11_MAX_INSTANCES);
+
+	INIT_WORK(&anb->work, gsv2k11_async_work);
+	anb->pending = 0;
+	anb->posted = 0;
+	anb->delivered = 0;
+
+	spin_lock(&gsv2k11_async_lock);
+	list_add_tail(&anb->node, &gsv2k11_async_list);
+	spin_unlock(&gsv2k11_async_lock);
+
+	return 0;
+}
+EXPORT_SYMBOL(gsv2k11_notifier_register_async);
+
+int gsv2k11_notifier_unregister_async(struct gsv2k11_async_nb *anb)
+{
+	spin_lock(&gsv2k11_async_lock);
+	list_del(&anb->node);
+	spin_unlock(&gsv2k11_async_lock);
+	cancel_work_sync(&anb->work);
+
+	return 0;
+}
+EXPORT_SYMBOL(gsv2k11_notifier_unregister_async);
+
 static int gsv2k11_probe(struct i2c_client *client, const struct i2c_device_id *id)
 {
 	int ret = 0;
@@ -503,8 +1779,17 @@ static int gsv2k11_probe(struct i2c_client *client, const struct i2c_device_id *
 		return -ENOMEM;
 	}
 	gsv2k11->client = client;
-	g_i2c_client = client;
 	i2c_set_clientdata(client, gsv2k11);
+	mutex_init(&gsv2k11->lock);
+	gsv2k11->poll_ms = GSV2K11_POLL_MS;
+	gsv2k11->tick_ms = GSV2K11_FAST_MS;
+	gsv2k11->min_blank_ms = GSV2K11_MIN_BLANK_MS;
+
+	gsv2k11->regmap = devm_regmap_init_i2c(client, &gsv2k11_regmap_config);
+	if (IS_ERR(gsv2k11->regmap)) {
+		dev_err(dev, "failed to init regmap\n");
+		return PTR_ERR(gsv2k11->regmap);
+	}
 
 	gsv2k11->reset_gpiod = devm_gpiod_get_optional(dev, "gsv2k11,reset", GPIOD_OUT_HIGH);
 	if (!gsv2k11->reset_gpiod) {
@@ -518,10 +1803,17 @@ static int gsv2k11_probe(struct i2c_client *client, const struct i2c_device_id *
 		return -ENODEV;
 	}
 
-	gsv2k11->gsv2k11_wq = create_singlethread_workqueue("gsv2k11-wq");
+	gsv2k11->index = ida_alloc_max(&gsv2k11_ida, AvMaxDeviceNumber - 1, GFP_KERNEL);
+	if (gsv2k11->index < 0) {
+		dev_err(dev, "no free gsv2k11 instance, max %d\n", AvMaxDeviceNumber);
+		return gsv2k11->index;
+	}
+
+	gsv2k11->gsv2k11_wq = alloc_ordered_workqueue("gsv2k11-%s", 0, dev_name(dev));
 	if (!gsv2k11->gsv2k11_wq) {
 		dev_err(dev, "failed to create workqueue for gsv2k11\n");
-		return -EINVAL;
+		ret = -EINVAL;
+		goto err_ida;
 	}
 	INIT_DELAYED_WORK(&gsv2k11->gsv2k11_delayed_work, gsv2k11_work);
 
@@ -532,19 +1824,71 @@ static int gsv2k11_probe(struct i2c_client *client, const struct i2c_device_id *
 		goto err;
 	}
 
+	ret = gsv2k11_v4l2_init(gsv2k11);
+	if (ret) {
+		dev_err(dev, "failed to register v4l2 subdev, ret = %d\n", ret);
+		goto err;
+	}
+
+	ret = gsv2k11_cec_init(gsv2k11);
+	if (ret) {
+		dev_err(dev, "failed to register cec adapter, ret = %d\n", ret);
+		goto err_cec;
+	}
+
+	/* last, the interrupt thread queues work on the workqueue torn down on error */
+	if (client->irq > 0) {
+		ret = devm_request_threaded_irq(dev, client->irq, NULL,
+				gsv2k11_irq_thread, IRQF_ONESHOT, dev_name(dev), gsv2k11);
+		if (ret) {
+			dev_err(dev, "failed to request irq %d, ret = %d\n", client->irq, ret);
+			goto err_v4l2;
+		}
+		gsv2k11->irq = client->irq;
+		gsv2k11->poll_ms = GSV2K11_IRQ_POLL_MS;
+		mutex_lock(&gsv2k11->lock);
+		AvApiEnableInterrupt(&gsv2k11->gsv2k11Ports[0], AV_BIT_INT_ALL, 1);
+		AvApiEnableInterrupt(&gsv2k11->gsv2k11Ports[1], AV_BIT_INT_ALL, 1);
+		mutex_unlock(&gsv2k11->lock);
+	}
+
 	queue_delayed_work(gsv2k11->gsv2k11_wq, &gsv2k11->gsv2k11_delayed_work, msecs_to_jiffies(0));
 
 	ret = devm_device_add_group(&client->dev, &gsv2k11_attribute_group);
 	if (ret) {
 		dev_err(dev, "failed to add group attr for gsv2k11\n");
-		goto err;
+		goto err_v4l2;
+	}
+
+	ret = devm_device_add_group(&client->dev, &gsv2k11_timing_group);
+	if (ret) {
+		dev_err(dev, "failed to add timing group for gsv2k11\n");
+		goto err_v4l2;
 	}
 
+	gsv2k11_debugfs_init(gsv2k11);
+
 	dev_info(dev, "gsv2k11 probe success\n");
 
 	return 0;
+err_v4l2:
+	if (gsv2k11->irq)
+		disable_irq(gsv2k11->irq);
+	del_timer_sync(&gsv2k11->gsv2k11_timer);
+	cancel_delayed_work_sync(&gsv2k11->gsv2k11_delayed_work);
+	/* the line stays requested until devm releases it, keep the chip quiet */
+	if (gsv2k11->irq) {
+		AvApiEnableInterrupt(&gsv2k11->gsv2k11Ports[0], AV_BIT_INT_ALL, 0);
+		AvApiEnableInterrupt(&gsv2k11->gsv2k11Ports[1], AV_BIT_INT_ALL, 0);
+	}
+	gsv2k11_cec_exit(gsv2k11);
+err_cec:
+	gsv2k11_v4l2_exit(gsv2k11);
 err:
+	AvApiRemoveDevice(&gsv2k11->devices[0]);
 	destroy_workqueue(gsv2k11->gsv2k11_wq);
+err_ida:
+	ida_free(&gsv2k11_ida, gsv2k11->index);
 	return ret;
 }
 
@@ -552,16 +1896,28 @@ static int gsv2k11_remove(struct i2c_client *client)
 {
 	struct gsv2k11_data *gsv2k11 = i2c_get_clientdata(client);
 
+	devm_device_remove_group(&client->dev, &gsv2k11_timing_group);
 	devm_device_remove_group(&client->dev, &gsv2k11_attribute_group);
+	debugfs_remove_recursive(gsv2k11->debugfs);
+
+	if (gsv2k11->irq)
+		disable_irq(gsv2k11->irq);
 
 	del_timer_sync(&gsv2k11->gsv2k11_timer);
 
 	cancel_delayed_work_sync(&gsv2k11->gsv2k11_delayed_work);
 
+	/* the worker posts source change events to the subdev until here */
+	gsv2k11_v4l2_exit(gsv2k11);
+	gsv2k11_cec_exit(gsv2k11);
+
 	if (gsv2k11->gsv2k11_wq) {
 		destroy_workqueue(gsv2k11->gsv2k11_wq);
 	}
 
+	AvApiRemoveDevice(&gsv2k11->devices[0]);
+	ida_free(&gsv2k11_ida, gsv2k11->index);
+
 	return 0;
 }
 
@@ -571,8 +1927,21 @@ static int gsv2k11_suspend(struct device *dev)
 	struct gsv2k11_data *gsv2k11 = dev_get_drvdata(dev);
 	int ret = 0;
 
+	if (gsv2k11->irq)
+		disable_irq(gsv2k11->irq);
 	del_timer_sync(&gsv2k11->gsv2k11_timer);
 	cancel_delayed_work_sync(&gsv2k11->gsv2k11_delayed_work);
+	gsv2k11_cec_suspend(gsv2k11);
+
+#if AvEnableFastResume
+	mutex_lock(&gsv2k11->lock);
+	AvApiSuspendDevice(&gsv2k11->devices[0]);
+	mutex_unlock(&gsv2k11->lock);
+#endif
+
+	/* the chip may lose power, every cached register is written back on resume */
+	regcache_cache_only(gsv2k11->regmap, true);
+	regcache_mark_dirty(gsv2k11->regmap);
 
 	return ret;
 }
@@ -581,7 +1950,49 @@ static int gsv2k11_resume(struct device *dev)
 {
 	struct gsv2k11_data *gsv2k11 = dev_get_drvdata(dev);
 	int ret = 0;
-
+	bool edid_lost = true;
+	bool restore = false;
+	int err;
+
+	mutex_lock(&gsv2k11->lock);
+	gsv2k11->resume_start = ktime_get();
+	gsv2k11->resuming = true;
+	gsv2k11->restored = 0;
+	regcache_cache_only(gsv2k11->regmap, false);
+	/* resets and triggers of the init table go first, in their order */
+	err = AvApiReplayDevice(&gsv2k11->devices[0]) == AvOk ? 0 : -EIO;
+	if (!err)
+		err = regcache_sync(gsv2k11->regmap);
+	if (err)
+		dev_warn(dev, "failed to restore registers, ret = %d\n", err);
+#if AvEnableFastResume
+	/*
+	 * with the configuration back in place the ports stable at suspend
+	 * carry on from their state if their link is unchanged, keeping edid
+	 * and routing, the others walk their FSMs from default.
+	 */
+	restore = !err;
+	if (restore)
+		edid_lost = AvApiRestoreDevice(&gsv2k11->devices[0],
+					       &gsv2k11->restored) != AvOk;
+#endif
+	/* registers and edid ram may have lost their content, drop their shadows */
+	if (!restore)
+		AvApiResumeDevice(&gsv2k11->devices[0]);
+#if AvEdidCacheEntries
+	if (edid_lost)
+		AvEdidFuncCacheRamLost(&gsv2k11->edid);
+#endif
+	/* the interrupt map is not cached */
+	if (gsv2k11->irq) {
+		AvApiEnableInterrupt(&gsv2k11->gsv2k11Ports[0], AV_BIT_INT_ALL, 1);
+		AvApiEnableInterrupt(&gsv2k11->gsv2k11Ports[1], AV_BIT_INT_ALL, 1);
+	}
+	gsv2k11_cec_resume(gsv2k11);
+	gsv2k11->tick_ms = GSV2K11_FAST_MS;
+	mutex_unlock(&gsv2k11->lock);
+	if (gsv2k11->irq)
+		enable_irq(gsv2k11->irq);
 	queue_delayed_work(gsv2k11->gsv2k11_wq,
 		&gsv2k11->gsv2k11_delayed_work, msecs_to_jiffies(0));
 
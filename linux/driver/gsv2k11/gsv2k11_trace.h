@@ -0,0 +1,45 @@
+/* SPDX-License-Identifier: GPL-2.0 */
+#undef TRACE_SYSTEM
+#define TRACE_SYSTEM gsv2k11
+
+#if !defined(_GSV2K11_TRACE_H) || defined(TRACE_HEADER_MULTI_READ)
+#define _GSV2K11_TRACE_H
+
+#include <linux/tracepoint.h>
+
+/* one FSM state change of one port, names resolved by the kapi */
+TRACE_EVENT(gsv2k11_fsm,
+
+	TP_PROTO(int instance, unsigned int port, const char *fsm,
+		 const char *from, const char *to),
+
+	TP_ARGS(instance, port, fsm, from, to),
+
+	TP_STRUCT__entry(
+		__field(int, instance)
+		__field(unsigned int, port)
+		__string(fsm, fsm)
+		__string(from, from)
+		__string(to, to)
+	),
+
+	TP_fast_assign(
+		__entry->instance = instance;
+		__entry->port = port;
+		__assign_str(fsm, fsm);
+		__assign_str(from, from);
+		__assign_str(to, to);
+	),
+
+	TP_printk("gsv2k11-%d port%u %s: %s -> %s",
+		  __entry->instance, __entry->port,
+		  __get_str(fsm), __get_str(from), __get_str(to))
+);
+
+#endif /* _GSV2K11_TRACE_H */
+
+#undef TRACE_INCLUDE_PATH
+#define TRACE_INCLUDE_PATH .
+#undef TRACE_INCLUDE_FILE
+#define TRACE_INCLUDE_FILE gsv2k11_trace
+#include <trace/define_trace.h>
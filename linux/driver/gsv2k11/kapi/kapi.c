@@ -8,11 +8,12 @@
 #include "../uapi/uapi.h"
 #include "kernel_status_update.h"
 
-static AvPort *FirstPort = NULL;
-static AvPort *PreviousPort = NULL;
 AvFpKeyCommand   AvHookKeyCmd;
 AvFpUartCommand  AvHookUartCmd;
 AvFpIrdaCommand  AvHookIrdaCmd;
+#if AvEnableCecFeature
+AvFpCecTransmit  AvHookCecTransmit;
+#endif
 void ClearVideoFromPort(pin AvPort *port);
 void ClearAudioFromPort(pin AvPort *port);
 
@@ -55,11 +56,25 @@ kapi AvRet AvApiAddDevice(AvDevice *device, AvDeviceType type, uint8 index,
     device->specific  = specific;
     device->port      = port;
     device->extension = extension;
+    device->bufferUsed = 0;
+    device->generation = 1;
 
-    return AvOk;
+    /* context, buffer and edid workspace are fed by the caller beforehand */
+    return AvUapiHookDeviceContext(device);
 
 }
 
+/**
+ * @brief  remove device
+ * @return none
+ * @note the i2c hooks must not reach the context of a removed device,
+ * its index may be handed to the next device added
+ */
+kapi AvRet AvApiRemoveDevice(AvDevice *device)
+{
+    return AvUapiUnhookDeviceContext(device);
+}
+
 /**
  * @brief  add audio/video port
  * @return none
@@ -69,17 +84,24 @@ kapi AvRet AvApiAddDevice(AvDevice *device, AvDeviceType type, uint8 index,
  */
 kapi AvRet AvApiAddPort(AvDevice *device, pin AvPort *port, uint16 index, AvPortType type)
 {
-    if(!FirstPort)
-        FirstPort = port;
+    AvPort *LastPort = (AvPort*)device->port;
 
     port->device = device;
     port->index  = index;
     port->type   = type;
+    port->generation = 0;
+    port->signature  = 0;
+    port->serviced   = 0;
+    port->skipped    = 0;
     AvApiPortMemAllocate(port);
 
-    if(PreviousPort)
-        PreviousPort->next = (struct AvPort*)port;
-    PreviousPort = port;
+    /* ports are chained per device, starting from the device first port */
+    if(LastPort != port)
+    {
+        while(LastPort->next)
+            LastPort = (AvPort*)LastPort->next;
+        LastPort->next = (struct AvPort*)port;
+    }
     port->next = NULL;
 
     return AvOk;
@@ -98,6 +120,143 @@ kapi AvRet AvApiInitDevice(AvDevice *device)
     return AvOk;
 }
 
+/**
+ * @brief  make every port program the chip again after suspend
+ * @return none
+ */
+static void AvKapiResumePorts(AvDevice *device)
+{
+#if AvEnableTxPacketCks
+    AvPort* TempPort = (AvPort*)device->port;
+
+    /* tx packet ram may be lost, forwarded packets are written again */
+    while(TempPort)
+    {
+        if(TempPort->type == HdmiTx)
+            KfunTxClearPacketSign(TempPort);
+        TempPort = (AvPort*)TempPort->next;
+    }
+#endif
+    /* derived ports have to program the chip again as well */
+    device->generation = device->generation + 1;
+}
+
+/**
+ * @brief  resume device
+ * @return none
+ * @note the chip may have lost its register content while suspended,
+ * every shadow of it is dropped and refilled from the chip
+ */
+kapi AvRet AvApiResumeDevice(AvDevice *device)
+{
+    AvKapiResumePorts(device);
+    return AvUapiResumeDevice(device);
+}
+
+/**
+ * @brief  replay the init writes the bsp register cache does not keep
+ * @return AvOk, AvError if a write failed
+ * @note the chip may have lost power while suspended, call this before
+ * the bsp writes its cached registers back
+ */
+kapi AvRet AvApiReplayDevice(AvDevice *device)
+{
+    return AvUapiReplayDevice(device);
+}
+
+#if AvEnableFastResume
+/**
+ * @brief  suspend device
+ * @return AvOk
+ * @note the hdmi ports sitting in their stable state are remembered, port
+ * contents, routing and generated edid stay in memory over suspend
+ */
+kapi AvRet AvApiSuspendDevice(AvDevice *device)
+{
+    AvPort* TempPort = (AvPort*)device->port;
+
+    while(TempPort)
+    {
+        TempPort->resume = 0;
+        if((TempPort->type == HdmiRx) &&
+           (*TempPort->content.is_PlugRxFsm == AvFsmPlugRxStable))
+            TempPort->resume = AvFsmPlugRxStable;
+        else if((TempPort->type == HdmiTx) &&
+                (*TempPort->content.is_PlugTxFsm == AvFsmPlugTxStable))
+            TempPort->resume = AvFsmPlugTxStable;
+        TempPort = (AvPort*)TempPort->next;
+    }
+    return AvOk;
+}
+
+/**
+ * @brief  resume device whose registers were written back by the bsp
+ * @return AvOk, AvError if the rx edid ram could not be written back
+ * @note Restored is 1 when every port stable at suspend kept its link and
+ * carries on from its fsm state, ports which lost or changed their link
+ * and ports not stable at suspend restart their plug fsm from default.
+ * Hdcp can not survive suspend, encrypted tx re-authenticate muted.
+ */
+kapi AvRet AvApiRestoreDevice(AvDevice *device, pout uint8 *Restored)
+{
+    AvPort* TempPort = (AvPort*)device->port;
+    uint8 Keep = 0;
+    AvRet ret = AvOk;
+
+    *Restored = 1;
+    AvKapiResumePorts(device);
+    ret = AvUapiRestoreDevice(device);
+
+    while(TempPort)
+    {
+        Keep = (ret == AvOk) && (TempPort->resume != 0) &&
+               (AvUapiRestorePort(TempPort) == AvOk);
+        if((TempPort->resume != 0) && (Keep == 0))
+            *Restored = 0;
+        if(TempPort->type == HdmiRx)
+        {
+            if(Keep == 0)
+                *TempPort->content.is_PlugRxFsm = AvFsmPlugRxDefault;
+        }
+        else if(TempPort->type == HdmiTx)
+        {
+            if(Keep == 0)
+                *TempPort->content.is_PlugTxFsm = AvFsmPlugTxDefault;
+            else if(TempPort->content.hdcptx->HdcpEnabled == 1)
+            {
+                TempPort->content.hdcptx->Authenticated = 0;
+                TempPort->content.hdcptx->Hdcp2p2TxRunning = 0;
+                *TempPort->content.is_PlugTxFsm = AvFsmPlugTxHdcp;
+                KfunTxSetMuteAv(TempPort);
+            }
+        }
+        TempPort->resume = 0;
+        TempPort = (AvPort*)TempPort->next;
+    }
+    return ret;
+}
+#endif
+
+/**
+ * @brief  check if a register is changed by the hardware
+ * @return 1 if volatile, 0 if its last written value can be cached and restored
+ * @note regAddress is the map page in bits 15:8 and the register in bits 7:0
+ */
+kapi uint8 AvApiRegisterVolatile(pin AvDevice *device, pin uint16 regAddress)
+{
+    return AvUapiRegisterVolatile(device, regAddress);
+}
+
+/**
+ * @brief  check if reading a register has a side effect
+ * @return 1 if precious, the bsp must not read it on its own
+ * @note regAddress is the map page in bits 15:8 and the register in bits 7:0
+ */
+kapi uint8 AvApiRegisterPrecious(pin AvDevice *device, pin uint16 regAddress)
+{
+    return AvUapiRegisterPrecious(device, regAddress);
+}
+
 /**
  * @brief  init fsm
  * @return none
@@ -154,15 +313,191 @@ kapi AvRet AvApiInitFsm(pin AvPort *port)
     return AvOk;
 }
 
+#if AvEnablePortDirtyTracking
+#define AvKapiSign(Sign, Value) ((Sign) = ((Sign) ^ (uint32)(Value)) * 16777619UL)
+#define AvKapiSignPort(Sign, Port) AvKapiSign(Sign, (Port) ? ((AvPort*)(Port))->index + 1 : 0)
+
 /**
- * @brief  update all ports status
+ * @brief  signature of everything other ports read from a port
+ * @return signature
+ * @note   fsm states, lock/hpd/edid status, video timing, colour and audio format,
+ *         the logic port settings with their Update flags and the routing
+ */
+static uint32 AvKapiPortSignature(pin AvPort *port)
+{
+    uint32 Sign = 2166136261UL;
+    AvContent *content = &port->content;
+#if AvEnableInternalClockGen
+    uint8 i;
+#endif
+
+    if(content->is_PlugRxFsm)
+        AvKapiSign(Sign, *content->is_PlugRxFsm);
+    if(content->is_ReceiverFsm)
+        AvKapiSign(Sign, *content->is_ReceiverFsm);
+    if(content->is_HdcpFsm)
+        AvKapiSign(Sign, *content->is_HdcpFsm);
+    if(content->is_PlugTxFsm)
+        AvKapiSign(Sign, *content->is_PlugTxFsm);
+    if(content->rx)
+    {
+        AvKapiSign(Sign, content->rx->Input5V);
+        AvKapiSign(Sign, content->rx->IsInputStable);
+        AvKapiSign(Sign, content->rx->IsFreeRun);
+        AvKapiSign(Sign, content->rx->VideoEncrypted);
+        AvKapiSign(Sign, content->rx->EdidStatus);
+        AvKapiSign(Sign, content->rx->Hpd);
+        AvKapiSign(Sign, content->rx->Lock.PllLock);
+        AvKapiSign(Sign, content->rx->Lock.AudioLock);
+    }
+    if(content->tx)
+    {
+        AvKapiSign(Sign, content->tx->Hpd);
+        AvKapiSign(Sign, content->tx->EdidReadSuccess);
+        AvKapiSign(Sign, content->tx->EdidSupportFeature);
+        AvKapiSign(Sign, content->tx->InfoReady);
+        AvKapiSign(Sign, content->tx->Lock.PllLock);
+    }
+    if(content->video)
+    {
+        /* the whole timing, non-VIC formats all share Vic 0 */
+        AvKapiSign(Sign, content->video->timing.Vic);
+        AvKapiSign(Sign, content->video->timing.HPolarity);
+        AvKapiSign(Sign, content->video->timing.VPolarity);
+        AvKapiSign(Sign, content->video->timing.Interlaced);
+#if AvEnableDetailTiming
+        AvKapiSign(Sign, content->video->timing.HActive);
+        AvKapiSign(Sign, content->video->timing.VActive);
+        AvKapiSign(Sign, content->video->timing.HTotal);
+        AvKapiSign(Sign, content->video->timing.VTotal);
+        AvKapiSign(Sign, content->video->timing.FrameRate);
+        AvKapiSign(Sign, content->video->timing.VSync);
+        AvKapiSign(Sign, content->video->timing.VBack);
+        AvKapiSign(Sign, content->video->timing.HSync);
+        AvKapiSign(Sign, content->video->timing.HBack);
+#endif
+        AvKapiSign(Sign, content->video->Cd);
+        AvKapiSign(Sign, content->video->Y);
+        AvKapiSign(Sign, content->video->InCs);
+        AvKapiSign(Sign, content->video->OutCs);
+        AvKapiSign(Sign, content->video->PixelRepeatValue);
+        AvKapiSign(Sign, content->video->AvailableVideoPackets);
+    }
+    if(content->audio)
+    {
+        AvKapiSign(Sign, content->audio->AudioMute);
+        AvKapiSign(Sign, content->audio->AudFormat);
+        AvKapiSign(Sign, content->audio->AudCoding);
+        AvKapiSign(Sign, content->audio->SampFreq);
+        AvKapiSign(Sign, content->audio->AvailableAudioPackets);
+    }
+    if(content->scaler)
+    {
+        AvKapiSign(Sign, content->scaler->Update);
+        AvKapiSign(Sign, content->scaler->ScalerInVic);
+        AvKapiSign(Sign, content->scaler->ColorSpace);
+    }
+    if(content->color)
+    {
+        AvKapiSign(Sign, content->color->Update);
+        AvKapiSign(Sign, content->color->ColorInVic);
+        AvKapiSign(Sign, content->color->ColorInSpace);
+        AvKapiSign(Sign, content->color->ColorInCs);
+        AvKapiSign(Sign, content->color->ColorOutSpace);
+        AvKapiSign(Sign, content->color->ColorOutCs);
+    }
+#if AvEnableVideoLogicBus
+    if(content->lvtx)
+    {
+        AvKapiSign(Sign, content->lvtx->Update);
+        AvKapiSign(Sign, content->lvtx->Config);
+        AvKapiSign(Sign, content->lvtx->Lock);
+    }
+    if(content->lvrx)
+    {
+        AvKapiSign(Sign, content->lvrx->Update);
+        AvKapiSign(Sign, content->lvrx->Config);
+        AvKapiSign(Sign, content->lvrx->Lock);
+    }
+#endif
+#if AvEnableInternalVideoGen
+    if(content->vg)
+    {
+        AvKapiSign(Sign, content->vg->Enable);
+        AvKapiSign(Sign, content->vg->Pattern);
+    }
+#endif
+#if AvEnableInternalAudioGen
+    if(content->ag)
+    {
+        AvKapiSign(Sign, content->ag->Enable);
+        AvKapiSign(Sign, content->ag->Update);
+    }
+#endif
+#if AvEnableInternalClockGen
+    if(content->cg)
+    {
+        for(i=0;i<4;i++)
+            AvKapiSign(Sign, content->cg->Update[i]);
+    }
+#endif
+    AvKapiSignPort(Sign, content->RouteVideoFromPort);
+    AvKapiSignPort(Sign, content->RouteVideoToPort);
+    AvKapiSignPort(Sign, content->RouteVideoNextSameLevelPort);
+    AvKapiSignPort(Sign, content->RouteAudioFromPort);
+    AvKapiSignPort(Sign, content->RouteAudioToPort);
+    AvKapiSignPort(Sign, content->RouteAudioNextSameLevelPort);
+
+    return Sign;
+}
+
+/**
+ * @brief  check whether a port needs to be updated
+ * @return 1 - update the port, 0 - the port is clean
+ * @note   ports polling hardware status are always updated, the derived
+ *         ports only when the device generation moved since their last
+ *         update or their own settings changed
+ */
+static uint8 AvKapiPortDirty(pin AvPort *port)
+{
+    switch(port->type)
+    {
+        case AnalogTx:
+        case VideoScaler:
+        case VideoColor:
+        case VideoGen:
+        case AudioGen:
+        case ClockGen:
+        case LogicAudioTx:
+            return ((port->generation != port->device->generation) ||
+                    (port->signature != AvKapiPortSignature(port)));
+        default:
+            return 1;
+    }
+}
+#endif
+
+/**
+ * @brief  update all ports status of a device
  * @return none
- * @note
+ * @note   with AvEnablePortDirtyTracking clean derived ports are skipped
+ */
+kapi AvRet AvApiUpdate(pin AvDevice *device)
+{
+    return AvApiUpdateExcept(device, 0);
+}
+
+/**
+ * @brief  update the ports of a device not updated yet in this tick
+ * @return none
+ * @note   bit n of Serviced is the nth port added to the device, those
+ *         ports were already updated by the interrupt path and are skipped
  */
-kapi AvRet AvApiUpdate(void)
+kapi AvRet AvApiUpdateExcept(pin AvDevice *device, uint32 Serviced)
 {
+    AvPort* FirstPort = (AvPort*)device->port;
     AvPort* TempPort = FirstPort;
-    uint8 OldState;
+    uint8 i = 0;
 
     while(TempPort)
     {
@@ -170,86 +505,304 @@ kapi AvRet AvApiUpdate(void)
         AvUserUartCmd(FirstPort);
         AvUserKeyCmd(FirstPort);
         AvUserIrdaCmd(FirstPort);
-        switch(TempPort->type)
+        if((i >= 32) || ((Serviced & ((uint32)1 << i)) == 0))
         {
-            case HdmiRx:
-            case DviRx:
-                OldState = *TempPort->content.is_PlugRxFsm;
-                KfunCheckPrState(TempPort);
-                AvKapiFsmFunPlugRxFsm(TempPort);
-                ReportPlugRxFsm(TempPort, OldState);
-                OldState = *TempPort->content.is_ReceiverFsm;
-                KfunCheckRxState(TempPort);
-                AvKapiFsmFunReceiverFsm(TempPort);
-                ReportReceiverFsm(TempPort, OldState);
-                OldState = *TempPort->content.is_HdcpFsm;
-                KfunCheckHdcpState(TempPort);
-                AvKapiFsmFunHdcpFsm(TempPort);
-                ReportHdcpFsm(TempPort, OldState);
-                break;
-            case AnalogRx:
-            case LogicVideoRx:
-                KfunCheckLogicVideoRx(TempPort);
-                KfunSimpleHdcpSync(TempPort);
-                break;
-            case LogicAudioRx:
+#if AvEnablePortDirtyTracking
+            if(AvKapiPortDirty(TempPort))
+                AvApiUpdatePort(TempPort);
+            else
+                TempPort->skipped = TempPort->skipped + 1;
+#else
+            AvApiUpdatePort(TempPort);
+#endif
+        }
+        i = i + 1;
+        if(!TempPort->next)
+            break;
+        else
+            TempPort = (AvPort*)TempPort->next;
+    }
+
+    return AvOk;
+}
+
+/**
+ * @brief  update a single port status
+ * @return none
+ * @note   used by AvApiUpdate and by the interrupt path to service only
+ *         the ports whose interrupt sources have fired
+ */
+kapi AvRet AvApiUpdatePort(pin AvPort *port)
+{
+    AvPort* TempPort = port;
+    uint8 OldState;
+#if AvEnablePortDirtyTracking
+    uint32 NewSignature;
+#endif
+
+    /* status registers of the port are read in a few bursts */
+    AvUapiSnapshotPort(TempPort);
+    switch(TempPort->type)
+    {
+        case HdmiRx:
+        case DviRx:
+            OldState = *TempPort->content.is_PlugRxFsm;
+            KfunCheckPrState(TempPort);
+            AvKapiFsmFunPlugRxFsm(TempPort);
+            ReportPlugRxFsm(TempPort, OldState);
+            OldState = *TempPort->content.is_ReceiverFsm;
+            KfunCheckRxState(TempPort);
+            AvKapiFsmFunReceiverFsm(TempPort);
+            ReportReceiverFsm(TempPort, OldState);
+            OldState = *TempPort->content.is_HdcpFsm;
+            KfunCheckHdcpState(TempPort);
+            AvKapiFsmFunHdcpFsm(TempPort);
+            ReportHdcpFsm(TempPort, OldState);
+            break;
+        case AnalogRx:
+        case LogicVideoRx:
+            KfunCheckLogicVideoRx(TempPort);
+            KfunSimpleHdcpSync(TempPort);
+            break;
+        case LogicAudioRx:
 #if AvEnableAudioTTLInput
-                KfunCheckLogicAudioRx(TempPort);
+            KfunCheckLogicAudioRx(TempPort);
 #endif
-                break;
-            case HdmiTx:
-                OldState = *TempPort->content.is_PlugTxFsm;
-                KfunCheckPtState(TempPort);
-                AvKapiFsmFunPlugTxFsm(TempPort);
-                ReportPlugTxFsm(TempPort, OldState);
+            break;
+        case HdmiTx:
+            OldState = *TempPort->content.is_PlugTxFsm;
+            KfunCheckPtState(TempPort);
+            AvKapiFsmFunPlugTxFsm(TempPort);
+            ReportPlugTxFsm(TempPort, OldState);
 #if AvEnableCecFeature /* CEC Related */
-                OldState = *TempPort->content.is_CecFsm;
-                KfunCheckCecState(TempPort);
-                AvKapiFsmFunCecFsm(TempPort);
-                ReportCecFsm(TempPort, OldState);
+            OldState = *TempPort->content.is_CecFsm;
+            KfunCheckCecState(TempPort);
+            AvKapiFsmFunCecFsm(TempPort);
+            ReportCecFsm(TempPort, OldState);
 #endif
-                break;
-            case DviTx:
-                KfunCheckPtState(TempPort);
-                AvKapiFsmFunPlugTxFsm(TempPort);
-                break;
-            case AnalogTx:
-            case LogicVideoTx:
-                KfunCheckLogicVideoTx(TempPort);
-                break;
-            case LogicAudioTx:
-                KfunCheckLogicAudioTx(TempPort);
-                break;
-            case VideoScaler:
-                KfunCheckVideoScaler(TempPort);
-                break;
-            case VideoColor:
-                KfunCheckVideoColor(TempPort);
-                break;
+            break;
+        case DviTx:
+            KfunCheckPtState(TempPort);
+            AvKapiFsmFunPlugTxFsm(TempPort);
+            break;
+        case AnalogTx:
+        case LogicVideoTx:
+            KfunCheckLogicVideoTx(TempPort);
+            break;
+        case LogicAudioTx:
+            KfunCheckLogicAudioTx(TempPort);
+            break;
+        case VideoScaler:
+            KfunCheckVideoScaler(TempPort);
+            break;
+        case VideoColor:
+            KfunCheckVideoColor(TempPort);
+            break;
 #if AvEnableInternalVideoGen
-            case VideoGen:
-                KfunCheckVideoGen(TempPort);
-                break;
+        case VideoGen:
+            KfunCheckVideoGen(TempPort);
+            break;
 #endif
 #if AvEnableInternalAudioGen
-            case AudioGen:
-                KfunCheckAudioGen(TempPort);
-                break;
+        case AudioGen:
+            KfunCheckAudioGen(TempPort);
+            break;
 #endif
 #if AvEnableInternalClockGen
-            case ClockGen:
-                KfunCheckClockGen(TempPort);
-                break;
+        case ClockGen:
+            KfunCheckClockGen(TempPort);
+            break;
 #endif
+        default:
+            break;
+    }
+    /* the next update reads fresh status */
+    AvHalI2cSnapshotDrop(AvGenerateDeviceAddress(port->device->index, 0, 0, 0));
+
+#if AvEnablePortDirtyTracking
+    /* a changed port dirties every derived port of the device */
+    NewSignature = AvKapiPortSignature(port);
+    if(NewSignature != port->signature)
+    {
+        port->signature = NewSignature;
+        port->device->generation = port->device->generation + 1;
+    }
+    port->generation = port->device->generation;
+#endif
+    port->serviced = port->serviced + 1;
+
+    return AvOk;
+}
+
+/**
+ * @brief  check whether the plug and receiver FSMs of a device have settled
+ * @return AvOk - success
+ * @note   Settled is 1 when every hdmi port sits in a state that only leaves
+ *         on an external event (source/sink plugged or lost, lock change),
+ *         0 while a port is walking through its tick-counted transients or
+ *         an hdcp handshake on either side
+ */
+kapi AvRet AvApiCheckSettled(pin AvDevice *device, pout uint8 *Settled)
+{
+    AvPort* TempPort = (AvPort*)device->port;
+
+    *Settled = 1;
+    while(TempPort)
+    {
+        switch(TempPort->type)
+        {
+            case HdmiRx:
+            case DviRx:
+                /* locked and receiving, or no source at all */
+                if(!(((*TempPort->content.is_PlugRxFsm == AvFsmPlugRxStable) &&
+                      (*TempPort->content.is_ReceiverFsm == AvFsmRxReceiving)) ||
+                     ((*TempPort->content.is_PlugRxFsm == AvFsmPlugRxPullDownHpd) &&
+                      (TempPort->content.rx->Input5V == 0))))
+                    *Settled = 0;
+                if((*TempPort->content.is_ReceiverFsm == AvFsmRxDefault) ||
+                   (*TempPort->content.is_ReceiverFsm == AvFsmRxReset))
+                    *Settled = 0;
+                /* hdcp idle or authenticated, everything else is mid handshake */
+                if((TempPort->type == HdmiRx) && (TempPort->content.is_HdcpFsm != NULL))
+                {
+                    switch(*TempPort->content.is_HdcpFsm)
+                    {
+                        case AvFsmHdcpDisable:
+                            /* leaves on the next tick once the input is stable */
+                            if((TempPort->content.hdcp->HdcpNeeded != 0) &&
+                               (TempPort->content.rx->IsInputStable != 0))
+                                *Settled = 0;
+                            break;
+                        case AvFsmNoActiveChild:
+                        case AvFsmHdcpDefault:
+                        case AvFsmHdcpUpstreamConnected:
+                        case AvFsmHdcpReceiverMode:
+                        case AvFsmHdcpRepeaterMode:
+                        case AvFsmHdcp2p2State:
+                            break;
+                        default:
+                            *Settled = 0;
+                            break;
+                    }
+                }
+                break;
+            case HdmiTx:
+            case DviTx:
+                switch(*TempPort->content.is_PlugTxFsm)
+                {
+                    /* InfoReady keeps counting ticks until hdcp is managed */
+                    case AvFsmPlugTxStable:
+                        if(TempPort->content.tx->InfoReady <= TxHdcpManageThreshold)
+                            *Settled = 0;
+                        /* encryption requested but not authenticated yet */
+                        if((TempPort->content.hdcptx != NULL) &&
+                           ((TempPort->content.hdcptx->HdcpModeUpdate != 0) ||
+                            ((TempPort->content.hdcptx->HdcpEnabled == 1) &&
+                             (TempPort->content.hdcptx->Authenticated == 0))))
+                            *Settled = 0;
+                        break;
+                    /* waiting for a sink */
+                    case AvFsmPlugTxReset:
+                        if(TempPort->content.tx->Hpd == AV_HPD_HIGH)
+                            *Settled = 0;
+                        break;
+                    /* waiting for a source */
+                    case AvFsmPlugTxEdidManage:
+                        if((TempPort->content.tx->EdidReadSuccess != AV_EDID_UPDATED) ||
+                           (TempPort->content.tx->Lock.PllLock == 1))
+                            *Settled = 0;
+                        break;
+                    case AvFsmPlugTxEdidError:
+                    case AvFsmPlugTxVideoUnlocked:
+                        break;
+                    default:
+                        *Settled = 0;
+                        break;
+                }
+                break;
             default:
                 break;
+        }
+        if(*Settled == 0)
+            break;
+        TempPort = (AvPort*)TempPort->next;
+    }
+
+    return AvOk;
+}
+
+/**
+ * @brief  check whether the transmitters of a device send the current video
+ * @return AvOk - success
+ * @note   Ready is 1 when every tx port with a sink has finished its
+ *         InfoReady delay after the last timing change and transmits,
+ *         tx ports without a sink do not hold it back
+ */
+kapi AvRet AvApiCheckVideoOut(pin AvDevice *device, pout uint8 *Ready)
+{
+    AvPort* TempPort = (AvPort*)device->port;
+
+    *Ready = 1;
+    while(TempPort)
+    {
+        if(((TempPort->type == HdmiTx) || (TempPort->type == DviTx)) &&
+           (TempPort->content.tx->Hpd == AV_HPD_HIGH))
+        {
+            if(((*TempPort->content.is_PlugTxFsm != AvFsmPlugTxStable) &&
+                (*TempPort->content.is_PlugTxFsm != AvFsmPlugTxHdcp)) ||
+               (TempPort->content.tx->Lock.PllLock == 0))
+            {
+                *Ready = 0;
+                break;
+            }
+        }
+        TempPort = (AvPort*)TempPort->next;
+    }
+
+    return AvOk;
+}
+
+/**
+ * @brief  read and decode the pending interrupt sources of a port
+ * @return AvOk - success
+ * @note   fired sources are masked off the interrupt pin until they
+ *         are rearmed by AvApiEnableInterrupt after the port is updated
+ */
+kapi AvRet AvApiGetInterrupt(pin AvPort *port, pout uint32 *IntEvents)
+{
+    *IntEvents = 0;
+    switch(port->type)
+    {
+        case HdmiRx:
+        case HdmiTx:
+            AvUapiGetInterrupt(port, IntEvents);
+            if(*IntEvents)
+            {
+                AvUapiEnableInterrupt(port, *IntEvents, 0);
+                port->device->generation = port->device->generation + 1;
             }
-        if(!TempPort->next)
             break;
-        else
-            TempPort = (AvPort*)TempPort->next;
+        default:
+            break;
     }
+    return AvOk;
+}
 
+/**
+ * @brief  route (or remove) port interrupt sources to the interrupt pin
+ * @return AvOk - success
+ */
+kapi AvRet AvApiEnableInterrupt(pin AvPort *port, uint32 IntEvents, uint8 Enable)
+{
+    switch(port->type)
+    {
+        case HdmiRx:
+        case HdmiTx:
+            AvUapiEnableInterrupt(port, IntEvents, Enable);
+            break;
+        default:
+            break;
+    }
     return AvOk;
 }
 
@@ -261,6 +814,9 @@ kapi AvRet AvApiUpdate(void)
 kapi AvRet AvApiConnectPort(pin AvPort *FromPort, pout AvPort *ToPort, AvConnectType type)
 {
     AvPort *TempPort = NULL;
+    /* routing changes dirty every derived port */
+    FromPort->device->generation = FromPort->device->generation + 1;
+    ToPort->device->generation = ToPort->device->generation + 1;
     /* Step 1. Assign Video Relation */
     if((type == AvConnectVideo) || (type == AvConnectAV))
     {
@@ -427,156 +983,156 @@ kapi AvRet AvApiPortMemAllocate(pin AvPort *port)
     {
         case HdmiRx:
         {
-            AvUapiAllocateMemory(sizeof(uint16),    (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(uint8),     (uint64 *)&(port->content.is_PlugRxFsm));
-            AvUapiAllocateMemory(sizeof(uint8),     (uint64 *)&(port->content.is_active_PlugRxFsm));
-            AvUapiAllocateMemory(sizeof(uint8),     (uint64 *)&(port->content.is_ReceiverFsm));
-            AvUapiAllocateMemory(sizeof(uint8),     (uint64 *)&(port->content.is_active_ReceiverFsm));
-            AvUapiAllocateMemory(sizeof(uint8),     (uint64 *)&(port->content.is_HdcpFsm));
-            AvUapiAllocateMemory(sizeof(uint8),     (uint64 *)&(port->content.is_active_HdcpFsm));
-            AvUapiAllocateMemory(sizeof(RxVars),    (uint64 *)&(port->content.rx));
-            AvUapiAllocateMemory(sizeof(HdcpRx),    (uint64 *)&(port->content.hdcp));
-            AvUapiAllocateMemory(sizeof(AvVideo),   (uint64 *)&(port->content.video));
-            AvUapiAllocateMemory(sizeof(AvAudio),   (uint64 *)&(port->content.audio));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),    (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),     (uint64 *)&(port->content.is_PlugRxFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),     (uint64 *)&(port->content.is_active_PlugRxFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),     (uint64 *)&(port->content.is_ReceiverFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),     (uint64 *)&(port->content.is_active_ReceiverFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),     (uint64 *)&(port->content.is_HdcpFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),     (uint64 *)&(port->content.is_active_HdcpFsm));
+            AvUapiAllocateMemory(port->device, sizeof(RxVars),    (uint64 *)&(port->content.rx));
+            AvUapiAllocateMemory(port->device, sizeof(HdcpRx),    (uint64 *)&(port->content.hdcp));
+            AvUapiAllocateMemory(port->device, sizeof(AvVideo),   (uint64 *)&(port->content.video));
+            AvUapiAllocateMemory(port->device, sizeof(AvAudio),   (uint64 *)&(port->content.audio));
             break;
         }
         case DviRx:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_PlugRxFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_active_PlugRxFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_ReceiverFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_active_ReceiverFsm));
-            AvUapiAllocateMemory(sizeof(RxVars),   (uint64 *)&(port->content.rx));
-            AvUapiAllocateMemory(sizeof(AvVideo),  (uint64 *)&(port->content.video));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_PlugRxFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_active_PlugRxFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_ReceiverFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_active_ReceiverFsm));
+            AvUapiAllocateMemory(port->device, sizeof(RxVars),   (uint64 *)&(port->content.rx));
+            AvUapiAllocateMemory(port->device, sizeof(AvVideo),  (uint64 *)&(port->content.video));
             break;
         }
         case AnalogRx:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_ReceiverFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_active_ReceiverFsm));
-            AvUapiAllocateMemory(sizeof(RxVars),   (uint64 *)&(port->content.rx));
-            AvUapiAllocateMemory(sizeof(AvVideo),  (uint64 *)&(port->content.video));
-            AvUapiAllocateMemory(sizeof(AvAudio),  (uint64 *)&(port->content.audio));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_ReceiverFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_active_ReceiverFsm));
+            AvUapiAllocateMemory(port->device, sizeof(RxVars),   (uint64 *)&(port->content.rx));
+            AvUapiAllocateMemory(port->device, sizeof(AvVideo),  (uint64 *)&(port->content.video));
+            AvUapiAllocateMemory(port->device, sizeof(AvAudio),  (uint64 *)&(port->content.audio));
             break;
         }
 #if AvEnableVideoLogicBus
         case LogicVideoRx:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_ReceiverFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_active_ReceiverFsm));
-            AvUapiAllocateMemory(sizeof(RxVars),   (uint64 *)&(port->content.rx));
-            AvUapiAllocateMemory(sizeof(AvVideo),  (uint64 *)&(port->content.video));
-            AvUapiAllocateMemory(sizeof(AvLogicVideo),(uint64 *)&(port->content.lvrx));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_ReceiverFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_active_ReceiverFsm));
+            AvUapiAllocateMemory(port->device, sizeof(RxVars),   (uint64 *)&(port->content.rx));
+            AvUapiAllocateMemory(port->device, sizeof(AvVideo),  (uint64 *)&(port->content.video));
+            AvUapiAllocateMemory(port->device, sizeof(AvLogicVideo),(uint64 *)&(port->content.lvrx));
             break;
         }
 #endif
         case LogicAudioRx:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(AvAudio),  (uint64 *)&(port->content.audio));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(AvAudio),  (uint64 *)&(port->content.audio));
             break;
         }
         case HdmiTx:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_PlugTxFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_active_PlugTxFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_TxRoutingFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_active_TxRoutingFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_HdcpFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_active_HdcpFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_PlugTxFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_active_PlugTxFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_TxRoutingFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_active_TxRoutingFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_HdcpFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_active_HdcpFsm));
 #if AvEnableCecFeature /* CEC Related */
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_CecFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_active_CecFsm));
-            AvUapiAllocateMemory(sizeof(AvCec),    (uint64 *)&(port->content.cec));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_CecFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_active_CecFsm));
+            AvUapiAllocateMemory(port->device, sizeof(AvCec),    (uint64 *)&(port->content.cec));
 #endif /* CEC Related */
-            AvUapiAllocateMemory(sizeof(TxVars),   (uint64 *)&(port->content.tx));
-            AvUapiAllocateMemory(sizeof(HdcpTx),   (uint64 *)&(port->content.hdcptx));
-            AvUapiAllocateMemory(sizeof(AvVideo),  (uint64 *)&(port->content.video));
-            AvUapiAllocateMemory(sizeof(AvAudio),  (uint64 *)&(port->content.audio));
+            AvUapiAllocateMemory(port->device, sizeof(TxVars),   (uint64 *)&(port->content.tx));
+            AvUapiAllocateMemory(port->device, sizeof(HdcpTx),   (uint64 *)&(port->content.hdcptx));
+            AvUapiAllocateMemory(port->device, sizeof(AvVideo),  (uint64 *)&(port->content.video));
+            AvUapiAllocateMemory(port->device, sizeof(AvAudio),  (uint64 *)&(port->content.audio));
             /* av_platf_enter_internal_HdcpFsm(port); */
             break;
         }
         case DviTx:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_PlugTxFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_active_PlugTxFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_TxRoutingFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_active_TxRoutingFsm));
-            AvUapiAllocateMemory(sizeof(TxVars),   (uint64 *)&(port->content.tx));
-            AvUapiAllocateMemory(sizeof(AvVideo),  (uint64 *)&(port->content.video));
-            AvUapiAllocateMemory(sizeof(AvAudio),  (uint64 *)&(port->content.audio));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_PlugTxFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_active_PlugTxFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_TxRoutingFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_active_TxRoutingFsm));
+            AvUapiAllocateMemory(port->device, sizeof(TxVars),   (uint64 *)&(port->content.tx));
+            AvUapiAllocateMemory(port->device, sizeof(AvVideo),  (uint64 *)&(port->content.video));
+            AvUapiAllocateMemory(port->device, sizeof(AvAudio),  (uint64 *)&(port->content.audio));
             break;
         }
         case AnalogTx:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_TxRoutingFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_active_TxRoutingFsm));
-            AvUapiAllocateMemory(sizeof(TxVars),   (uint64 *)&(port->content.tx));
-            AvUapiAllocateMemory(sizeof(AvVideo),  (uint64 *)&(port->content.video));
-            AvUapiAllocateMemory(sizeof(AvAudio),  (uint64 *)&(port->content.audio));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_TxRoutingFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_active_TxRoutingFsm));
+            AvUapiAllocateMemory(port->device, sizeof(TxVars),   (uint64 *)&(port->content.tx));
+            AvUapiAllocateMemory(port->device, sizeof(AvVideo),  (uint64 *)&(port->content.video));
+            AvUapiAllocateMemory(port->device, sizeof(AvAudio),  (uint64 *)&(port->content.audio));
             break;
         }
         case VideoScaler:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(AvScaler), (uint64 *)&(port->content.scaler));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(AvScaler), (uint64 *)&(port->content.scaler));
             break;
         }
         case VideoColor:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(AvColor),  (uint64 *)&(port->content.color));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(AvColor),  (uint64 *)&(port->content.color));
             break;
         }
 #if AvEnableInternalVideoGen
         case VideoGen:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(RxVars),   (uint64 *)&(port->content.rx));
-            AvUapiAllocateMemory(sizeof(AvVideo),  (uint64 *)&(port->content.video));
-            AvUapiAllocateMemory(sizeof(AvVideoGen),(uint64 *)&(port->content.vg));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(RxVars),   (uint64 *)&(port->content.rx));
+            AvUapiAllocateMemory(port->device, sizeof(AvVideo),  (uint64 *)&(port->content.video));
+            AvUapiAllocateMemory(port->device, sizeof(AvVideoGen),(uint64 *)&(port->content.vg));
             break;
         }
 #endif
 #if AvEnableInternalAudioGen
         case AudioGen:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(RxVars),   (uint64 *)&(port->content.rx));
-            AvUapiAllocateMemory(sizeof(AvAudio),  (uint64 *)&(port->content.audio));
-            AvUapiAllocateMemory(sizeof(AvAudioGen),(uint64 *)&(port->content.ag));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(RxVars),   (uint64 *)&(port->content.rx));
+            AvUapiAllocateMemory(port->device, sizeof(AvAudio),  (uint64 *)&(port->content.audio));
+            AvUapiAllocateMemory(port->device, sizeof(AvAudioGen),(uint64 *)&(port->content.ag));
             break;
         }
 #endif
 #if AvEnableInternalClockGen
         case ClockGen:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(AvClockGen),(uint64 *)&(port->content.cg));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(AvClockGen),(uint64 *)&(port->content.cg));
             break;
         }
 #endif
 #if AvEnableVideoLogicBus
         case LogicVideoTx:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_TxRoutingFsm));
-            AvUapiAllocateMemory(sizeof(uint8),    (uint64 *)&(port->content.is_active_TxRoutingFsm));
-            AvUapiAllocateMemory(sizeof(AvVideo),  (uint64 *)&(port->content.video));
-            AvUapiAllocateMemory(sizeof(AvLogicVideo),(uint64 *)&(port->content.lvtx));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_TxRoutingFsm));
+            AvUapiAllocateMemory(port->device, sizeof(uint8),    (uint64 *)&(port->content.is_active_TxRoutingFsm));
+            AvUapiAllocateMemory(port->device, sizeof(AvVideo),  (uint64 *)&(port->content.video));
+            AvUapiAllocateMemory(port->device, sizeof(AvLogicVideo),(uint64 *)&(port->content.lvtx));
             break;
         }
 #endif
         case LogicAudioTx:
         {
-            AvUapiAllocateMemory(sizeof(uint16),   (uint64 *)&(port->content.ID));
-            AvUapiAllocateMemory(sizeof(AvAudio),  (uint64 *)&(port->content.audio));
+            AvUapiAllocateMemory(port->device, sizeof(uint16),   (uint64 *)&(port->content.ID));
+            AvUapiAllocateMemory(port->device, sizeof(AvAudio),  (uint64 *)&(port->content.audio));
             break;
         }
         default:
@@ -656,9 +1212,9 @@ void ClearAudioFromPort(pin AvPort *port)
  * @return none
  * @note this function is used for initializing port FSMs.
  */
-kapi AvRet AvApiPortStart(void)
+kapi AvRet AvApiPortStart(pin AvDevice *device)
 {
-    AvPort *TempPort = FirstPort;
+    AvPort *TempPort = (AvPort*)device->port;
     while(TempPort)
     {
         AvApiInitFsm(TempPort);
@@ -688,4 +1244,87 @@ kapi AvRet AvKapiArcEnable(AvPort *port, uint8 value)
     return AvUapiTxArcEnable(port, value);
 }
 
+/**
+ * @brief  hand the cec engine over to an external cec stack
+ * @return AvOk - success
+ * @note   the cec fsm keeps running as a client: its frames go out through
+ *         cecTx, received frames and tx results come back through
+ *         AvApiCecReceived and AvApiCecTransmitted. NULL gives it back.
+ */
+kapi AvRet AvApiHookCecTransport(pin AvFpCecTransmit cecTx)
+{
+    AvHookCecTransmit = cecTx;
+    return AvOk;
+}
+
+/**
+ * @brief  pass a frame received by the external cec stack to the cec fsm
+ * @return AvOk - success
+ */
+kapi AvRet AvApiCecReceived(pin AvPort *port, pin uint8 *Msg, uint8 Len)
+{
+    if((port->content.cec == NULL) || (Len == 0) || (Len > 16))
+        return AvInvalidParameter;
+    AvMemcpy(port->content.cec->RxContent, Msg, Len);
+    port->content.cec->RxLen = Len;
+    port->content.cec->RxGetFlag = 1;
+    KfunCecRxMsgProcess(port);
+    port->content.cec->RxGetFlag = 0;
+    return AvOk;
+}
+
+/**
+ * @brief  report the result of a frame sent through the cec transport hook
+ * @return AvOk - success
+ * @note   Status holds AV_BIT_CEC_TX_* bits, NackCount is what the logical
+ *         address allocation compares against
+ */
+kapi AvRet AvApiCecTransmitted(pin AvPort *port, uint8 Status, uint8 NackCount)
+{
+    if(port->content.cec == NULL)
+        return AvInvalidParameter;
+    port->content.cec->TxReady = (Status & AV_BIT_CEC_TX_READY) ? 1 : 0;
+    port->content.cec->ArbLost = (Status & AV_BIT_CEC_TX_ARB_LOST) ? 1 : 0;
+    port->content.cec->Timeout = (Status & AV_BIT_CEC_TX_TIMEOUT) ? 1 : 0;
+    port->content.cec->NackCount = NackCount;
+    if(port->content.cec->TxSendFlag == AV_CEC_TX_WAIT_RESPONSE)
+    {
+        if(port->content.cec->TxReady)
+            port->content.cec->TxSendFlag = AV_CEC_TX_SEND_SUCCESS;
+        else
+            port->content.cec->TxSendFlag = AV_CEC_TX_SEND_FAIL;
+    }
+    return AvOk;
+}
+
 #endif /* CEC Related */
+
+/**
+ * @brief  raw access to the cec engine for an external cec stack
+ * @return AvOk - success
+ * @note   independent of AvEnableCecFeature, see AvUapiCecEnable and friends
+ */
+kapi AvRet AvApiCecEnable(pin AvPort *port, uint8 Enable)
+{
+    return AvUapiCecEnable(port, Enable);
+}
+
+kapi AvRet AvApiCecSetLogAddr(pin AvPort *port, uint8 Slot, uint8 LogAddr)
+{
+    return AvUapiCecSetLogAddr(port, Slot, LogAddr);
+}
+
+kapi AvRet AvApiCecTransmit(pin AvPort *port, pin uint8 *Msg, uint8 Len, uint8 Retry)
+{
+    return AvUapiCecTransmit(port, Msg, Len, Retry);
+}
+
+kapi AvRet AvApiCecGetTxStatus(pin AvPort *port, pout uint8 *Status, pout uint8 *NackCount, pout uint8 *LowDriveCount)
+{
+    return AvUapiCecGetTxStatus(port, Status, NackCount, LowDriveCount);
+}
+
+kapi AvRet AvApiCecReceive(pin AvPort *port, pout uint8 *Msg, pout uint8 *Len)
+{
+    return AvUapiCecReceive(port, Msg, Len);
+}
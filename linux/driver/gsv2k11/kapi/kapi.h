@@ -26,6 +26,20 @@ typedef void (*AvFpKeyCommand) (AvPort *port);
 typedef void (*AvFpUartCommand) (AvPort *port);
 typedef void (*AvFpIrdaCommand) (AvPort *port);
 
+/* fsm ids reported to the fsm transition hook */
+typedef enum
+{
+    AvFsmIdPlugRx,
+    AvFsmIdReceiver,
+    AvFsmIdHdcp,
+    AvFsmIdPlugTx,
+    AvFsmIdCec
+} AvFsmId;
+
+typedef void (*AvFpFsmTransition) (AvPort *port, uint8 Fsm, uint8 OldState, uint8 NewState);
+/* sends port->content.cec->TxContent, result reported by AvApiCecTransmitted */
+typedef AvRet (*AvFpCecTransmit) (AvPort *port);
+
 #define AvUserUartCmd       AvHookUartCmd
 #define AvUserKeyCmd        AvHookKeyCmd
 #define AvUserIrdaCmd       AvHookIrdaCmd
@@ -33,6 +47,8 @@ typedef void (*AvFpIrdaCommand) (AvPort *port);
 
 #define AvApiHookBspFunctions   AvUapiHookBspFunctions
 #define AvApiHookUserFunctions  AvKapiHookUserFunctions
+#define AvApiHookBspSleep       AvUapiHookBspSleep
+extern AvRet AvUapiHookBspSleep(pin AvFpSleepMilliSecond sleepMs);
 extern AvRet AvUapiHookBspFunctions(pin AvFpI2cRead i2cRd,
                                     pin AvFpI2cWrite i2cWr,
                                     pin AvFpUartSendByte uartTxB,
@@ -45,19 +61,48 @@ kapi AvRet AvKapiHookUserFunctions(pin AvFpKeyCommand keyCmd, pin AvFpUartComman
 kapi AvRet AvApiInit(void);
 kapi AvRet AvApiAddDevice(AvDevice *device, AvDeviceType type, uint8 index,
                            void *specific, void *port,  void *extension);
+kapi AvRet AvApiRemoveDevice(AvDevice *device);
 kapi AvRet AvApiAddPort(AvDevice *device, pin AvPort *port, uint16 index, AvPortType type);
 kapi AvRet AvApiInitDevice(AvDevice *device);
+kapi AvRet AvApiResumeDevice(AvDevice *device);
+kapi AvRet AvApiReplayDevice(AvDevice *device);
+#if AvEnableFastResume
+#if (AvEdidRamShadow == 0)
+#error "AvEnableFastResume needs AvEdidRamShadow"
+#endif
+kapi AvRet AvApiSuspendDevice(AvDevice *device);
+kapi AvRet AvApiRestoreDevice(AvDevice *device, pout uint8 *Restored);
+#endif
+kapi uint8 AvApiRegisterVolatile(pin AvDevice *device, pin uint16 regAddress);
+kapi uint8 AvApiRegisterPrecious(pin AvDevice *device, pin uint16 regAddress);
 kapi AvRet AvApiInitFsm(pin AvPort *port);
-kapi AvRet AvApiUpdate(void);
+kapi AvRet AvApiUpdate(pin AvDevice *device);
+kapi AvRet AvApiUpdateExcept(pin AvDevice *device, uint32 Serviced);
+kapi AvRet AvApiUpdatePort(pin AvPort *port);
+kapi AvRet AvApiCheckSettled(pin AvDevice *device, pout uint8 *Settled);
+kapi AvRet AvApiCheckVideoOut(pin AvDevice *device, pout uint8 *Ready);
+kapi AvRet AvApiGetInterrupt(pin AvPort *port, pout uint32 *IntEvents);
+kapi AvRet AvApiEnableInterrupt(pin AvPort *port, uint32 IntEvents, uint8 Enable);
 kapi AvRet AvApiTriggerEvent(pout AvEvent event);
 kapi AvRet AvApiConnectPort(pin AvPort *FromPort, pin AvPort *ToPort, AvConnectType type);
 kapi AvRet AvApiPortMemAllocate(pin AvPort *port);
-kapi AvRet AvApiPortStart(void);
+kapi AvRet AvApiPortStart(pin AvDevice *device);
 
 kapi AvRet AvKapiCecSendMessage(AvPort *port);
 kapi AvRet AvKapiCecSetPhysicalAddr(AvPort *port);
 kapi AvRet AvKapiCecSetLogicalAddr(AvPort *port);
 kapi AvRet AvKapiArcEnable(AvPort *port, uint8 value);
+kapi AvRet AvApiCecEnable(pin AvPort *port, uint8 Enable);
+kapi AvRet AvApiCecSetLogAddr(pin AvPort *port, uint8 Slot, uint8 LogAddr);
+kapi AvRet AvApiCecTransmit(pin AvPort *port, pin uint8 *Msg, uint8 Len, uint8 Retry);
+kapi AvRet AvApiCecGetTxStatus(pin AvPort *port, pout uint8 *Status, pout uint8 *NackCount, pout uint8 *LowDriveCount);
+kapi AvRet AvApiCecReceive(pin AvPort *port, pout uint8 *Msg, pout uint8 *Len);
+#if AvEnableCecFeature
+extern AvFpCecTransmit AvHookCecTransmit;
+kapi AvRet AvApiHookCecTransport(pin AvFpCecTransmit cecTx);
+kapi AvRet AvApiCecReceived(pin AvPort *port, pin uint8 *Msg, uint8 Len);
+kapi AvRet AvApiCecTransmitted(pin AvPort *port, uint8 Status, uint8 NackCount);
+#endif
 #if  AvEnableDebugMessage
 //#define AvKapiOutputDebugMessage AvUapiOuputDbgMsg
 #define AvKapiOutputDebugMessage printk
@@ -81,6 +126,10 @@ void PrintPlugRxFsm(AvPort *Port, uint8 OldState);
 void PrintReceiverFsm(AvPort *Port, uint8 OldState);
 void PrintCecFsm(AvPort *Port, uint8 OldState);
 
+kapi AvRet AvApiHookFsmTransition(pin AvFpFsmTransition fsmTransition);
+kapi const char *AvApiFsmName(pin uint8 Fsm);
+kapi const char *AvApiFsmStateName(pin uint8 Fsm, pin uint8 State);
+
 /* 2. FSM State Definition */
 #define AvKapiFsmFunTxRoutingFsm      AvFsmFunTxRoutingFsm
 #define AvKapiFsmFunPlugTxFsm         AvFsmFunPlugTxFsm
@@ -2,107 +2,181 @@
 #include "kapi.h"
 #include "../uapi/uapi.h"
 
-void PrintHdcpFsm(AvPort *Port, uint8 OldState)
+static AvFpFsmTransition AvKapiFsmHook = NULL;
+
+/* hdcp fsm state names */
+static const char *AvKapiHdcpStateName(uint8 State)
 {
-    if(*Port->content.is_HdcpFsm != OldState)
+    switch(State)
     {
-        switch(*Port->content.is_HdcpFsm)
-        {
-           case AvFsmHdcpDefault:
-            AvUapiOutputDebugFsm("Port%d: HdcpDefault",Port->index);
-            break;
-
-           case AvFsmHdcpDisable:
-            AvUapiOutputDebugFsm("Port%d: HdcpDisable",Port->index);
-            break;
-
-           case AvFsmHdcpFail:
-            AvUapiOutputDebugFsm("Port%d: HdcpFail",Port->index);
-            break;
+        case AvFsmHdcpDefault: return "HdcpDefault";
+        case AvFsmHdcpDisable: return "HdcpDisable";
+        case AvFsmHdcpFail: return "HdcpFail";
+        case AvFsmHdcp2p2State: return "Hdcp2p2State";
+        case AvFsmHdcpReAuthentication: return "HdcpReAuthentication";
+        case AvFsmHdcpReadBksv: return "HdcpReadBksv";
+        case AvFsmHdcpReceiverMode: return "HdcpReceiverMode";
+        case AvFsmHdcpRepeaterMode: return "HdcpRepeaterMode";
+        case AvFsmHdcpRepeaterReset: return "HdcpRepeaterReset";
+        case AvFsmHdcpRequestSinkHdcp: return "HdcpRequestSinkHdcp";
+        case AvFsmHdcpStartAuthentication: return "HdcpStartAuthentication";
+        case AvFsmHdcpUpstreamConnected: return "HdcpUpstreamConnected";
+        default: break;
+    }
+    return "Unknown";
+}
 
-           case AvFsmHdcp2p2State:
-            AvUapiOutputDebugFsm("Port%d: Hdcp2p2State",Port->index);
-            break;
+/* plug tx fsm state names */
+static const char *AvKapiPlugTxStateName(uint8 State)
+{
+    switch(State)
+    {
+        case AvFsmPlugTxEdidError: return "PlugTxEdidError";
+        case AvFsmPlugTxDefault: return "PlugTxDefault";
+        case AvFsmPlugTxDefaultEdid: return "PlugTxDefaultEdid";
+        case AvFsmPlugTxEdid: return "PlugTxEdid";
+        case AvFsmPlugTxEdidManage: return "PlugTxEdidManage";
+        case AvFsmPlugTxEnableTxCore: return "PlugTxEnableTxCore";
+        case AvFsmPlugTxHdcp: return "PlugTxHdcp";
+        case AvFsmPlugTxHpdAntiDither: return "PlugTxHpdAntiDither";
+        case AvFsmPlugTxReset: return "PlugTxReset";
+        case AvFsmPlugTxStable: return "PlugTxStable";
+        case AvFsmPlugTxTransmitVideo: return "PlugTxTransmitVideo";
+        case AvFsmPlugTxVideoUnlocked: return "PlugTxVideoUnlocked";
+        default: break;
+    }
+    return "Unknown";
+}
 
-           case AvFsmHdcpReAuthentication:
-            AvUapiOutputDebugFsm("Port%d: HdcpReAuthentication",Port->index);
-            break;
+/* plug rx fsm state names */
+static const char *AvKapiPlugRxStateName(uint8 State)
+{
+    switch(State)
+    {
+        case AvFsmPlugRxDefault: return "PlugRxDefault";
+        case AvFsmPlugRxDetect: return "PlugRxDetect";
+        case AvFsmPlugRxInfoUpdate: return "PlugRxInfoUpdate";
+        case AvFsmPlugRxInputLock: return "PlugRxInputLock";
+        case AvFsmPlugRxPlugged: return "PlugRxPlugged";
+        case AvFsmPlugRxPullDownHpd: return "PlugRxPullDownHpd";
+        case AvFsmPlugRxReadTiming: return "PlugRxReadTiming";
+        case AvFsmPlugRxReset: return "PlugRxReset";
+        case AvFsmPlugRxStable: return "PlugRxStable";
+        default: break;
+    }
+    return "Unknown";
+}
 
-           case AvFsmHdcpReadBksv:
-            AvUapiOutputDebugFsm("Port%d: HdcpReadBksv",Port->index);
-            break;
+/* receiver fsm state names */
+static const char *AvKapiReceiverStateName(uint8 State)
+{
+    switch(State)
+    {
+        case AvFsmRxDefault: return "RxDefault";
+        case AvFsmRxDetect: return "RxDetect";
+        case AvFsmRxFreerun: return "RxFreerun";
+        case AvFsmRxReceiving: return "RxReceiving";
+        case AvFsmRxReset: return "RxReset";
+        default: break;
+    }
+    return "Unknown";
+}
 
-           case AvFsmHdcpReceiverMode:
-            AvUapiOutputDebugFsm("Port%d: HdcpReceiverMode",Port->index);
-            break;
+#if AvEnableCecFeature /* CEC Related */
+/* cec fsm state names */
+static const char *AvKapiCecStateName(uint8 State)
+{
+    switch(State)
+    {
+        case AvFsmCecDefault: return "CecDefault";
+        case AvFsmCecIdle: return "CecIdle";
+        case AvFsmCecNotConnected: return "CecNotConnected";
+        case AvFsmCecReset: return "CecReset";
+        case AvFsmCecTxLogAddr: return "CecTxLogAddr";
+        case AvFsmCecAudioControl: return "CecAudioControl";
+        case AvFsmCecAudioFormat: return "CecAudioFormat";
+        case AvFsmCecAudioManage: return "CecAudioManage";
+        case AvFsmCecCmdARC: return "CecCmdARC";
+        case AvFsmCecCmdAudioARC: return "CecCmdAudioARC";
+        case AvFsmCecCmdSystemAudioModetoAll: return "CecCmdSystemAudioModetoAll";
+        case AvFsmCecFunctionalDefault: return "CecFunctionalDefault";
+        case AvFsmCecCmdActiveSource: return "CecCmdActiveSource";
+        default: break;
+    }
+    return "Unknown";
+}
+#endif /* CEC Related */
 
-           case AvFsmHdcpRepeaterMode:
-            AvUapiOutputDebugFsm("Port%d: HdcpRepeaterMode",Port->index);
-            break;
+/**
+ * @brief  hook a function called on every fsm state change
+ * @return AvOk
+ * @note   called from the fsm tick, must not block
+ */
+kapi AvRet AvApiHookFsmTransition(pin AvFpFsmTransition fsmTransition)
+{
+    AvKapiFsmHook = fsmTransition;
+    return AvOk;
+}
 
-           case AvFsmHdcpRepeaterReset:
-            AvUapiOutputDebugFsm("Port%d: HdcpRepeaterReset",Port->index);
-            break;
+/**
+ * @brief  name of a fsm
+ * @return fsm name, "Unknown" for an invalid id
+ */
+kapi const char *AvApiFsmName(pin uint8 Fsm)
+{
+    switch(Fsm)
+    {
+        case AvFsmIdPlugRx:   return "PlugRx";
+        case AvFsmIdReceiver: return "Receiver";
+        case AvFsmIdHdcp:     return "Hdcp";
+        case AvFsmIdPlugTx:   return "PlugTx";
+        case AvFsmIdCec:      return "Cec";
+        default: break;
+    }
+    return "Unknown";
+}
 
-           case AvFsmHdcpRequestSinkHdcp:
-            AvUapiOutputDebugFsm("Port%d: HdcpRequestSinkHdcp",Port->index);
-            break;
+/**
+ * @brief  name of a fsm state
+ * @return state name, "Unknown" for an invalid fsm or state
+ */
+kapi const char *AvApiFsmStateName(pin uint8 Fsm, pin uint8 State)
+{
+    switch(Fsm)
+    {
+        case AvFsmIdPlugRx:   return AvKapiPlugRxStateName(State);
+        case AvFsmIdReceiver: return AvKapiReceiverStateName(State);
+        case AvFsmIdHdcp:     return AvKapiHdcpStateName(State);
+        case AvFsmIdPlugTx:   return AvKapiPlugTxStateName(State);
+#if AvEnableCecFeature /* CEC Related */
+        case AvFsmIdCec:      return AvKapiCecStateName(State);
+#endif
+        default: break;
+    }
+    return "Unknown";
+}
 
-           case AvFsmHdcpStartAuthentication:
-            AvUapiOutputDebugFsm("Port%d: HdcpStartAuthentication",Port->index);
-            break;
+/**
+ * @brief  report a fsm state change to the debug output and the hook
+ * @return none
+ */
+static void AvKapiFsmTransition(AvPort *Port, uint8 Fsm, uint8 OldState, uint8 NewState)
+{
+    AvUapiOutputDebugFsm("Port%d: %s", Port->index, AvApiFsmStateName(Fsm, NewState));
+    if(AvKapiFsmHook != NULL)
+        AvKapiFsmHook(Port, Fsm, OldState, NewState);
+}
 
-           case AvFsmHdcpUpstreamConnected:
-            AvUapiOutputDebugFsm("Port%d: HdcpUpstreamConnected",Port->index);
-            break;
-        }
-    }
+void PrintHdcpFsm(AvPort *Port, uint8 OldState)
+{
+    if(*Port->content.is_HdcpFsm != OldState)
+        AvKapiFsmTransition(Port, AvFsmIdHdcp, OldState, *Port->content.is_HdcpFsm);
 }
 
 void PrintPlugTxFsm(AvPort *Port, uint8 OldState)
 {
     if(*Port->content.is_PlugTxFsm != OldState)
-    {
-        switch (*Port->content.is_PlugTxFsm)
-        {
-          case AvFsmPlugTxEdidError:
-              AvUapiOutputDebugFsm("Port%d: PlugTxEdidError", Port->index);
-            break;
-          case AvFsmPlugTxDefault:
-              AvUapiOutputDebugFsm("Port%d: PlugTxDefault", Port->index);
-            break;
-          case AvFsmPlugTxDefaultEdid:
-              AvUapiOutputDebugFsm("Port%d: PlugTxDefaultEdid", Port->index);
-            break;
-          case AvFsmPlugTxEdid:
-              AvUapiOutputDebugFsm("Port%d: PlugTxEdid", Port->index);
-            break;
-          case AvFsmPlugTxEdidManage:
-              AvUapiOutputDebugFsm("Port%d: PlugTxEdidManage", Port->index);
-            break;
-          case AvFsmPlugTxEnableTxCore:
-              AvUapiOutputDebugFsm("Port%d: PlugTxEnableTxCore", Port->index);
-            break;
-          case AvFsmPlugTxHdcp:
-              AvUapiOutputDebugFsm("Port%d: PlugTxHdcp", Port->index);
-            break;
-          case AvFsmPlugTxHpdAntiDither:
-              AvUapiOutputDebugFsm("Port%d: PlugTxHpdAntiDither", Port->index);
-            break;
-          case AvFsmPlugTxReset:
-              AvUapiOutputDebugFsm("Port%d: PlugTxReset", Port->index);
-            break;
-          case AvFsmPlugTxStable:
-              AvUapiOutputDebugFsm("Port%d: PlugTxStable", Port->index);
-            break;
-          case AvFsmPlugTxTransmitVideo:
-              AvUapiOutputDebugFsm("Port%d: PlugTxTransmitVideo", Port->index);
-            break;
-          case AvFsmPlugTxVideoUnlocked:
-              AvUapiOutputDebugFsm("Port%d: PlugTxVideoUnlocked", Port->index);
-            break;
-        }
-    }
+        AvKapiFsmTransition(Port, AvFsmIdPlugTx, OldState, *Port->content.is_PlugTxFsm);
 }
 
 void PrintPlugRxFsm(AvPort *Port, uint8 OldState)
@@ -111,112 +185,28 @@ void PrintPlugRxFsm(AvPort *Port, uint8 OldState)
     {
         switch (*Port->content.is_PlugRxFsm)
         {
-          case AvFsmPlugRxDefault:
-              AvUapiOutputDebugFsm("Port%d: PlugRxDefault", Port->index);
-            break;
-          case AvFsmPlugRxDetect:
-              AvUapiOutputDebugFsm("Port%d: PlugRxDetect", Port->index);
-            break;
-          case AvFsmPlugRxInfoUpdate:
-              AvUapiOutputDebugFsm("Port%d: PlugRxInfoUpdate", Port->index);
-            break;
           case AvFsmPlugRxInputLock:
               AvHandleEvent(Port, AvEventPortUpStreamConnected, NULL, NULL);
-              AvUapiOutputDebugFsm("Port%d: PlugRxInputLock", Port->index);
-            break;
-          case AvFsmPlugRxPlugged:
-              AvUapiOutputDebugFsm("Port%d: PlugRxPlugged", Port->index);
             break;
           case AvFsmPlugRxPullDownHpd:
               if(Port->content.rx->Input5V == 0)
                   AvHandleEvent(Port, AvEventPortUpStreamDisconnected, NULL, NULL);
-              AvUapiOutputDebugFsm("Port%d: PlugRxPullDownHpd", Port->index);
-            break;
-          case AvFsmPlugRxReadTiming:
-              AvUapiOutputDebugFsm("Port%d: PlugRxReadTiming", Port->index);
-            break;
-          case AvFsmPlugRxReset:
-              AvUapiOutputDebugFsm("Port%d: PlugRxReset", Port->index);
-            break;
-          case AvFsmPlugRxStable:
-              AvUapiOutputDebugFsm("Port%d: PlugRxStable", Port->index);
             break;
         }
+        AvKapiFsmTransition(Port, AvFsmIdPlugRx, OldState, *Port->content.is_PlugRxFsm);
     }
 }
 
 void PrintReceiverFsm(AvPort *Port, uint8 OldState)
 {
     if(*Port->content.is_ReceiverFsm != OldState)
-    {
-        switch (*Port->content.is_ReceiverFsm)
-        {
-          case AvFsmRxDefault:
-            AvUapiOutputDebugFsm("Port%d: RxDefault", Port->index);
-            break;
-          case AvFsmRxDetect:
-            AvUapiOutputDebugFsm("Port%d: RxDetect", Port->index);
-            break;
-          case AvFsmRxFreerun:
-            AvUapiOutputDebugFsm("Port%d: RxFreerun", Port->index);
-            break;
-          case AvFsmRxReceiving:
-            AvUapiOutputDebugFsm("Port%d: RxReceiving", Port->index);
-            break;
-          case AvFsmRxReset:
-            AvUapiOutputDebugFsm("Port%d: RxReset", Port->index);
-            break;
-        }
-    }
+        AvKapiFsmTransition(Port, AvFsmIdReceiver, OldState, *Port->content.is_ReceiverFsm);
 }
 
 #if AvEnableCecFeature /* CEC Related */
 void PrintCecFsm(AvPort *Port, uint8 OldState)
 {
     if(*Port->content.is_CecFsm != OldState)
-    {
-        switch (*Port->content.is_CecFsm)
-        {
-          case AvFsmCecDefault:
-            AvUapiOutputDebugFsm("Port%d: CecDefault", Port->index);
-            break;
-          case AvFsmCecIdle:
-            AvUapiOutputDebugFsm("Port%d: CecIdle", Port->index);
-            break;
-          case AvFsmCecNotConnected:
-            AvUapiOutputDebugFsm("Port%d: CecNotConnected", Port->index);
-            break;
-          case AvFsmCecReset:
-            AvUapiOutputDebugFsm("Port%d: CecReset", Port->index);
-            break;
-          case AvFsmCecTxLogAddr:
-            AvUapiOutputDebugFsm("Port%d: CecTxLogAddr", Port->index);
-            break;
-          case AvFsmCecAudioControl:
-            AvUapiOutputDebugFsm("Port%d: CecAudioControl", Port->index);
-            break;
-          case AvFsmCecAudioFormat:
-            AvUapiOutputDebugFsm("Port%d: CecAudioFormat", Port->index);
-            break;
-          case AvFsmCecAudioManage:
-            AvUapiOutputDebugFsm("Port%d: CecAudioManage", Port->index);
-            break;
-          case AvFsmCecCmdARC:
-            AvUapiOutputDebugFsm("Port%d: CecCmdARC", Port->index);
-            break;
-          case AvFsmCecCmdAudioARC:
-            AvUapiOutputDebugFsm("Port%d: CecCmdAudioARC", Port->index);
-            break;
-          case AvFsmCecCmdSystemAudioModetoAll:
-            AvUapiOutputDebugFsm("Port%d: CecCmdSystemAudioModetoAll", Port->index);
-            break;
-          case AvFsmCecFunctionalDefault:
-            AvUapiOutputDebugFsm("Port%d: CecFunctionalDefault", Port->index);
-            break;
-          case AvFsmCecCmdActiveSource:
-            AvUapiOutputDebugFsm("Port%d: CecCmdActiveSource", Port->index);
-            break;
-        }
-    }
+        AvKapiFsmTransition(Port, AvFsmIdCec, OldState, *Port->content.is_CecFsm);
 }
 #endif /* CEC Related */
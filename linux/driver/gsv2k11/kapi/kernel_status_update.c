@@ -316,6 +316,9 @@ void KfunCheckCecState(AvPort *port)
         case AvFsmCecReset:
             break;
         default:
+            /* with the cec transport hooked, frames and results are pushed in */
+            if(AvHookCecTransmit != NULL)
+                break;
             AvUapiCecRxGetStatus(port);
             AvUapiCecTxGetStatus(port);
             if(port->content.cec->RxGetFlag)
@@ -53,9 +53,85 @@ void KfunRxInit(pin AvPort *port)
     return;
 }
 
+#if AvEnableTxPacketCks
+#define KfunSign(Sign, Value) ((Sign) = ((Sign) ^ (uint32)(Value)) * 16777619UL)
+
+/**
+ * @brief
+ * function to sign what a Tx packet write programs: packet body and,
+ * for AVI, the Tx video state that goes into the TXDIG/TXPKT setting
+ * @return packet signature, never 0
+ * @note
+ */
+uint32 KfunTxPacketSign(pin AvPort *port, PacketType Pkt, uint8 *Content)
+{
+    uint32 Sign = 2166136261UL;
+    uint8 i = 0;
+
+    for(i=0; i<PktSize[Pkt]; i++)
+        KfunSign(Sign, Content[i]);
+    if(Pkt == AV_PKT_AV_INFO_FRAME)
+    {
+        KfunSign(Sign, port->content.tx->HdmiMode);
+        KfunSign(Sign, port->content.video->Y);
+        KfunSign(Sign, port->content.video->InCs);
+        KfunSign(Sign, port->content.video->OutCs);
+        KfunSign(Sign, port->content.video->timing.Vic);
+        KfunSign(Sign, port->content.video->PixelRepeatValue);
+        if(port->content.RouteVideoFromPort != NULL)
+            KfunSign(Sign, ((AvPort*)port->content.RouteVideoFromPort)->type);
+        else
+            KfunSign(Sign, 0xff);
+    }
+    if(Sign == 0)
+        Sign = 1;
+
+    return Sign;
+}
+
+/**
+ * @brief
+ * function to skip a Tx packet write when the same content is already programmed
+ * @return 1 - packet content unchanged, 0 - packet has to be written
+ * @note   Audio Channel Status also unmutes Tx audio, it is always written
+ */
+uint8 KfunTxPacketUnchanged(pio AvPort *port, PacketType Pkt, uint8 *Content, uint8 Enabled)
+{
+    uint32 Sign = 0;
+
+    if((Pkt >= AV_PKT_ALL_PACKETS) || (Pkt == AV_PKT_AUDIO_CHANNEL_STATUS))
+        return 0;
+    Sign = KfunTxPacketSign(port, Pkt, Content);
+    if((Enabled != 0) && (port->content.tx->PktSign[Pkt] == Sign))
+    {
+        port->content.tx->PktSuppressed = port->content.tx->PktSuppressed + 1;
+        return 1;
+    }
+    port->content.tx->PktSign[Pkt] = Sign;
+    port->content.tx->PktForwarded = port->content.tx->PktForwarded + 1;
+
+    return 0;
+}
+
+/**
+ * @brief
+ * function to forget programmed Tx packets, next forward writes them again
+ * @return none
+ * @note
+ */
+void KfunTxClearPacketSign(pio AvPort *port)
+{
+    AvMemset(port->content.tx->PktSign, 0, sizeof(port->content.tx->PktSign));
+}
+#else
+#define KfunTxPacketUnchanged(port, Pkt, Content, Enabled) ((void)(Enabled), 0)
+#endif
+
 void KfunTxfromRxPacketContent(AvPort *RxPort, AvPort *TxPort, uint8 *PktContent, uint16 AvBit,
                                PacketType AvPacket, AvPacketType type, AvRxUpdateType update)
 {
+    uint8 Enabled = 0;
+
     if(type == AvVideoPacketType)
     {
         if(((RxPort->content.video->AvailableVideoPackets & AvBit) != 0) || (update == AvRxForce))
@@ -67,7 +143,9 @@ void KfunTxfromRxPacketContent(AvPort *RxPort, AvPort *TxPort, uint8 *PktContent
             }
             KfunCheckVspPortContent(TxPort, AvPacket, PktContent);
             KfunUpdatePortFromPacket(TxPort, AvPacket, PktContent);
-            AvUapiTxSetPacketContent(TxPort, AvPacket, PktContent, 1);
+            Enabled = ((TxPort->content.video->AvailableVideoPackets & AvBit) != 0);
+            if(KfunTxPacketUnchanged(TxPort, AvPacket, PktContent, Enabled) == 0)
+                AvUapiTxSetPacketContent(TxPort, AvPacket, PktContent, 1);
             TxPort->content.video->AvailableVideoPackets =
                 TxPort->content.video->AvailableVideoPackets | AvBit;
         }
@@ -89,7 +167,9 @@ void KfunTxfromRxPacketContent(AvPort *RxPort, AvPort *TxPort, uint8 *PktContent
             }
             KfunCheckVspPortContent(TxPort, AvPacket, PktContent);
             KfunUpdatePortFromPacket(TxPort, AvPacket, PktContent);
-            AvUapiTxSetPacketContent(TxPort, AvPacket, PktContent, 1);
+            Enabled = ((TxPort->content.audio->AvailableAudioPackets & AvBit) != 0);
+            if(KfunTxPacketUnchanged(TxPort, AvPacket, PktContent, Enabled) == 0)
+                AvUapiTxSetPacketContent(TxPort, AvPacket, PktContent, 1);
             TxPort->content.audio->AvailableAudioPackets =
                 TxPort->content.audio->AvailableAudioPackets | AvBit;
         }
@@ -107,6 +187,10 @@ void KfunRxtoTxPacketContent(AvPort *port, uint8 *PktContent, uint16 AvBit,
 {
     AvPort *CurrentPort = NULL;
     AvPort *PrevPort = NULL;
+#if AvEnablePacketIntGate
+    /* body is read once here, every Tx end gets its own copy to adjust */
+    uint8 TxContent[40];
+#endif
 
     if(type == AvVideoPacketType)
     {
@@ -120,7 +204,14 @@ void KfunRxtoTxPacketContent(AvPort *port, uint8 *PktContent, uint16 AvBit,
         while(KfunFindVideoNextTxEnd(port, &PrevPort, &CurrentPort) == AvOk)
         {
             if(CurrentPort->type == HdmiTx)
+            {
+#if AvEnablePacketIntGate
+                AvMemcpy(TxContent, PktContent, sizeof(TxContent));
+                KfunTxfromRxPacketContent(port, CurrentPort, TxContent, AvBit, AvPacket, type, AvRxKeep);
+#else
                 KfunTxfromRxPacketContent(port, CurrentPort, PktContent, AvBit, AvPacket, type, AvRxUpdate);
+#endif
+            }
             PrevPort = CurrentPort;
             CurrentPort = NULL;
         }
@@ -137,7 +228,14 @@ void KfunRxtoTxPacketContent(AvPort *port, uint8 *PktContent, uint16 AvBit,
         while(KfunFindAudioNextTxEnd(port, &PrevPort, &CurrentPort) == AvOk)
         {
             if(CurrentPort->type == HdmiTx)
+            {
+#if AvEnablePacketIntGate
+                AvMemcpy(TxContent, PktContent, sizeof(TxContent));
+                KfunTxfromRxPacketContent(port, CurrentPort, TxContent, AvBit, AvPacket, type, AvRxKeep);
+#else
                 KfunTxfromRxPacketContent(port, CurrentPort, PktContent, AvBit, AvPacket, type, AvRxUpdate);
+#endif
+            }
             PrevPort = CurrentPort;
             CurrentPort = NULL;
         }
@@ -1105,7 +1203,10 @@ void KfunPrHpdDown(pin AvPort *port)
 {
     AvUapiRxSetHpdDown(port);
     if(port->content.rx->Hpd != AV_HPD_LOW)
+    {
         port->content.rx->HpdDelayExpire = 0;
+        AvHalGetMilliSecond(&port->content.rx->HpdLowStart);
+    }
     else
         port->content.rx->HpdDelayExpire = RxHpdDelayExpireThreshold;
     port->content.rx->Hpd = AV_HPD_LOW;
@@ -1132,6 +1233,7 @@ void KfunManageHpa(pin AvPort *port)
     AvPort *PrevPort = NULL;
     AvPort *CurrentPort = NULL;
     uint8 ValidSinkFlag = 1;
+    uint32 NowMs = 0;
 #if AvForceDefaultEdid
     if(port->content.rx->EdidStatus == AV_EDID_NEEDUPDATE)
         port->content.rx->EdidStatus = AV_EDID_UPDATED;
@@ -1150,7 +1252,10 @@ void KfunManageHpa(pin AvPort *port)
     {
         if(port->content.rx->Hpd == AV_HPD_LOW)
         {
-            if(port->content.rx->HpdDelayExpire >= RxHpdDelayExpireThreshold)
+            /* the source must see the low pulse, however fast the tick is */
+            AvHalGetMilliSecond(&NowMs);
+            if((port->content.rx->HpdDelayExpire >= RxHpdDelayExpireThreshold) &&
+               ((NowMs - port->content.rx->HpdLowStart) >= RxHpdLowMinMs))
             {
                 /* Only Pull UP HPA when Valid Sink is available */
                 while(KfunFindVideoNextTxEnd(port, &PrevPort, &CurrentPort) == AvOk)
@@ -1273,6 +1378,7 @@ void KfunPtVarInit(pout AvPort *port)
     port->content.tx->InfoReady = 0;
     port->content.tx->EdidReadFail = 0;
     port->content.tx->EdidReadSuccess = AV_EDID_RESET;
+    port->content.tx->EdidWaiting = 0;
     port->content.tx->IgnoreEdidError = 0; /* for test without EDID fun */
     port->content.tx->Hpd = AV_HPD_LOW; /* RELEASE_LOW */
     port->content.tx->HpdDelayExpire = 0;
@@ -1306,8 +1412,10 @@ void KfunPtResetPort(pout AvPort *port)
     port->content.tx->Lock.AudioLock = 1;
     port->content.tx->EdidReadFail = 0;
     port->content.tx->EdidReadSuccess = AV_EDID_RESET;
+    port->content.tx->EdidWaiting = 0;
     port->content.tx->Hpd = AV_HPD_LOW; /* RELEASE_LOW */
     port->content.tx->InfoReady = 0;
+    KfunTxClearPacketSign(port);
     AvUapiResetPort(port);
 #if AvEnableHdcp2p2Feature
     port->content.hdcptx->Hdcp2p2TxRunning = 0;
@@ -1347,6 +1455,33 @@ void KfunPtAntiDither(pout AvPort *port)
     return;
 }
 
+/**
+ * @brief
+ * function to check whether InfoReady may count one more tick
+ * @return 1 - count, 0 - hold
+ * @note   InfoReady counts ticks, but the video and hdcp manage thresholds
+ *         are not reached before TxVideoManageMs and TxHdcpManageMs since
+ *         its first step, whatever the tick period
+ */
+static uint8 KfunTxInfoReadyDue(pin AvPort *port)
+{
+    uint8 Next = port->content.tx->InfoReady + 1;
+    uint32 NowMs = 0;
+
+    if(port->content.tx->InfoReady > TxHdcpManageThreshold)
+        return 0;
+    AvHalGetMilliSecond(&NowMs);
+    if(port->content.tx->InfoReady == 0)
+        port->content.tx->InfoReadyStart = NowMs;
+    if((Next == TxVideoManageThreshold) &&
+       ((NowMs - port->content.tx->InfoReadyStart) < TxVideoManageMs))
+        return 0;
+    if((Next == TxHdcpManageThreshold) &&
+       ((NowMs - port->content.tx->InfoReadyStart) < TxHdcpManageMs))
+        return 0;
+    return 1;
+}
+
 /**
  * @brief
  * function to Manage Video in HDMI Tx
@@ -1373,7 +1508,7 @@ AvRet KfunTxVideoManage(pout AvPort *port)
         UpperPort = (AvPort*)port->content.RouteVideoFromPort;
         ret = AvOk;
         /* InfoReady Delay Implement */
-        if(port->content.tx->InfoReady <= TxHdcpManageThreshold)
+        if(KfunTxInfoReadyDue(port) == 1)
         {
             port->content.tx->InfoReady = port->content.tx->InfoReady + 1;
             //AvUapiOutputDebugMessage("Port%d: InfoReady = %d", port->index, port->content.tx->InfoReady);
@@ -2695,7 +2830,33 @@ AvRet KfunCecSendMessage(AvPort *port)
 {
     AvRet ret = AvOk;
     port->content.cec->TxSendFlag = AV_CEC_TX_TO_SEND;
-    AvUapiCecSendMessage(port);
+    KfunCecTransmit(port);
+    return ret;
+}
+
+/**
+ * @brief
+ * function to send the prepared CEC frame, by the chip or the cec transport hook
+ * @return AvOk - success
+ * @note
+ */
+AvRet KfunCecTransmit(AvPort *port)
+{
+    AvRet ret = AvOk;
+
+    if(AvHookCecTransmit == NULL)
+        return AvUapiCecSendMessage(port);
+
+    port->content.cec->TxReady = 0;
+    port->content.cec->ArbLost = 0;
+    port->content.cec->Timeout = 0;
+    port->content.cec->TxSendFlag = AV_CEC_TX_WAIT_RESPONSE;
+    ret = AvHookCecTransmit(port);
+    if(ret != AvOk)
+    {
+        port->content.cec->Timeout = 1;
+        port->content.cec->TxSendFlag = AV_CEC_TX_SEND_FAIL;
+    }
     return ret;
 }
 
@@ -2715,7 +2876,7 @@ void SendSetSystemAudioMode (AvPort* port, uint8 status)
     AV_CEC_SET_OPCODE(port->content.cec->TxContent,
                    AV_CEC_MSG_SET_SYSTEM_AUDIO_MODE);
     port->content.cec->TxContent[2] = status;
-    AvUapiCecSendMessage(port);
+    KfunCecTransmit(port);
 }
 
 /**
@@ -2742,7 +2903,7 @@ AvRet CecAllocateLogAddr(AvPort* port)
      *========================================*/
     port->content.cec->TxContent[0] = (port->content.cec->AddrIndex & 0xf) |
                                      ((port->content.cec->AddrIndex & 0xf) << 4);
-    ret = AvUapiCecSendMessage(port);
+    ret = KfunCecTransmit(port);
     return ret;
 }
 
@@ -2795,7 +2956,9 @@ AvRet KfunPrepareLogAddr (AvPort* port)
             }
             else if(port->content.cec->Timeout)
             {
-                AvUapiGetNackCount(port);
+                /* the cec transport hook reports the nack count itself */
+                if(AvHookCecTransmit == NULL)
+                    AvUapiGetNackCount(port);
                 /*=============================================
                  * No response, logical addr available, exit
                  *============================================*/
@@ -2867,7 +3030,8 @@ AvRet KfunPrepareLogAddr (AvPort* port)
  */
 AvRet KfunCecInit (AvPort* port)
 {
-    AvUapiTxCecInit(port);
+    if(AvHookCecTransmit == NULL)
+        AvUapiTxCecInit(port);
     if(port->content.cec->EnableAudioAmplifier == AV_CEC_AMP_ENABLED)
         port->content.cec->EnableAudioAmplifier = AV_CEC_AMP_TO_ENABLE;
     if(port->content.cec->EnableAudioAmplifier == AV_CEC_AMP_DISABLED)
@@ -2885,7 +3049,8 @@ AvRet KfunCecInit (AvPort* port)
  */
 AvRet KfunCecSetPhysicalAddr(pin AvPort *port)
 {
-    AvUapiTxCecSetPhysicalAddr(port);
+    if(AvHookCecTransmit == NULL)
+        AvUapiTxCecSetPhysicalAddr(port);
     return AvOk;
 }
 
@@ -2897,7 +3062,8 @@ AvRet KfunCecSetPhysicalAddr(pin AvPort *port)
  */
 AvRet KfunCecSetLogicalAddr(pin AvPort *port)
 {
-    AvUapiTxCecSetLogicalAddr(port);
+    if(AvHookCecTransmit == NULL)
+        AvUapiTxCecSetLogicalAddr(port);
     return AvOk;
 }
 
@@ -2976,7 +3142,9 @@ AvRet KfunCecUpdateFromEdid(AvPort *port)
 
     if(port->type == HdmiTx)
     {
-        AvUapiTxReadEdid(port, Edid, AvEdidMaxSize);
+        /* edid ram busy, read it again on the next tick */
+        if(AvUapiTxReadEdid(port, Edid, AvEdidMaxSize) == AvNotAvailable)
+            return AvNotAvailable;
         /* Incorrect Edid, Return */
         if((Edid[6] != 0xFF) || (Edid[7] != 0x00))
         {
@@ -3052,9 +3220,9 @@ AvRet KfunTxEdidError(pin AvPort *port)
     return AvOk;
 }
 
-void KfunTxReadEdid(AvPort *port, uint8 *ReadData)
+AvRet KfunTxReadEdid(AvPort *port, uint8 *ReadData)
 {
-    AvUapiTxReadEdid(port, ReadData, AvEdidMaxSize);
+    return AvUapiTxReadEdid(port, ReadData, AvEdidMaxSize);
 }
 
 void KfunRxWriteEdid(pio AvPort *port, uint8 *MergedEdid, uint8 SpaLocation, uint8 *SpaValue)
@@ -76,6 +76,13 @@ AvRet KfunCecUpdateFromEdid(AvPort *port);
 AvRet KfunTxSinkLost(AvPort *port);
 void KfunTxSetColorDepth(AvPort *RxPort, AvPort *TxPort);
 void KfunTxSetHdmiModeSupport(pout AvPort *port);
+#if AvEnableTxPacketCks
+uint32 KfunTxPacketSign(pin AvPort *port, PacketType Pkt, uint8 *Content);
+uint8 KfunTxPacketUnchanged(pio AvPort *port, PacketType Pkt, uint8 *Content, uint8 Enabled);
+void KfunTxClearPacketSign(pio AvPort *port);
+#else
+#define KfunTxClearPacketSign(...)
+#endif
 
 /* PART 4 */
 /* Routing FSM */
@@ -94,7 +101,7 @@ void KfunPrepareEdid(pin AvPort *port);
 void KfunStdiReadStatus(pin AvPort *port);
 void KfunRxReadInfo(pin AvPort *port);
 void KfunRxWriteEdid(pio AvPort *port, uint8 *MergedEdid, uint8 SpaLocation, uint8 *SpaValue);
-void KfunTxReadEdid(AvPort *port, uint8 *ReadData);
+AvRet KfunTxReadEdid(AvPort *port, uint8 *ReadData);
 
 /* PART 6 */
 /* Plug TX FSM */
@@ -114,6 +121,7 @@ AvRet KfunCecInit(AvPort *port);
 AvRet KfunCecRxMsgProcess(AvPort *port);
 AvRet KfunPrepareLogAddr(AvPort *port);
 AvRet KfunCecSendMessage(AvPort *port);
+AvRet KfunCecTransmit(AvPort *port);
 AvRet KfunCecSetPhysicalAddr(AvPort *port);
 AvRet KfunCecSetLogicalAddr(AvPort *port);
 AvRet KfunCecManage(AvPort *port);
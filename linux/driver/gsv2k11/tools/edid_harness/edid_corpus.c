@@ -0,0 +1,327 @@
+/**
+ * @file edid_corpus.c
+ *
+ * @brief sink edids fed to the host edid merge harness
+ */
+#include "edid_harness.h"
+
+/* DVI-D monitor, EDID 1.3, no extension block */
+static const uint8 Edid_dvi_monitor_1p3[256] = {
+    0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x10,0xac,0x7b,0xa0,0x30,0x33,0x4a,0x4c,
+    0x0c,0x13,0x01,0x03,0x80,0x34,0x20,0x78,0xea,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0xa5,0x4b,0x00,0x81,0x80,0xa9,0x40,0x71,0x4f,0x81,0x00,0xd1,0x00,
+    0x01,0x01,0x01,0x01,0x01,0x01,0x28,0x3c,0x80,0xa0,0x70,0xb0,0x23,0x40,0x30,0x20,
+    0x36,0x00,0x06,0x44,0x21,0x00,0x00,0x1a,0x00,0x00,0x00,0xff,0x00,0x47,0x32,0x38,
+    0x36,0x48,0x39,0x41,0x42,0x31,0x32,0x4c,0x4c,0x0a,0x00,0x00,0x00,0xfc,0x00,0x44,
+    0x45,0x4c,0x4c,0x20,0x32,0x34,0x30,0x38,0x57,0x46,0x50,0x0a,0x00,0x00,0x00,0xfd,
+    0x00,0x38,0x4c,0x1e,0x53,0x11,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0xe7,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+};
+
+/* HDMI 1.4 TV, HDMI VSDB with SPA 1.0.0.0, deep colour, 3D */
+static const uint8 Edid_hdmi14_tv[256] = {
+    0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x4c,0x2d,0x2e,0x0b,0x00,0x0e,0x00,0x01,
+    0x14,0x16,0x01,0x03,0x80,0x66,0x39,0x78,0x0a,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0x23,0x08,0x00,0x81,0xc0,0x81,0x00,0x81,0x80,0x95,0x00,0xa9,0xc0,
+    0xb3,0x00,0x01,0x01,0x01,0x01,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,
+    0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,
+    0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x00,0x00,0x00,0xfd,0x00,0x18,
+    0x4b,0x1a,0x51,0x17,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xfc,
+    0x00,0x53,0x41,0x4d,0x53,0x55,0x4e,0x47,0x0a,0x20,0x20,0x20,0x20,0x20,0x01,0xcb,
+    0x02,0x03,0x2d,0xf0,0x4b,0x90,0x1f,0x04,0x13,0x05,0x14,0x03,0x12,0x20,0x21,0x22,
+    0x26,0x09,0x07,0x07,0x15,0x07,0x50,0x6d,0x03,0x0c,0x00,0x10,0x00,0xb8,0x2d,0x20,
+    0xd0,0x0e,0x01,0x40,0x00,0x83,0x01,0x00,0x00,0xe3,0x05,0x03,0x01,0x02,0x3a,0x80,
+    0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,
+    0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,
+    0x1e,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x10,
+};
+
+/* HDMI 2.0 4K TV, HF-VSDB, Y420 VDB and CMDB, HDR static, Dolby Vision */
+static const uint8 Edid_hdmi20_4k_hdr_tv[256] = {
+    0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x1e,0x6d,0x07,0x77,0x01,0x01,0x01,0x01,
+    0x01,0x1d,0x01,0x03,0x80,0xa0,0x5a,0x78,0x0a,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0x21,0x08,0x00,0x71,0x40,0x81,0xc0,0x81,0x80,0x81,0x00,0xa9,0xc0,
+    0xd1,0xc0,0x01,0x01,0x01,0x01,0x08,0xe8,0x00,0x30,0xf2,0x70,0x5a,0x80,0xb0,0x58,
+    0x8a,0x00,0xba,0xa8,0x42,0x00,0x00,0x1e,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,
+    0x58,0x2c,0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x00,0x00,0x00,0xfd,0x00,0x18,
+    0x78,0x1e,0xff,0x77,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xfc,
+    0x00,0x4c,0x47,0x20,0x54,0x56,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x01,0x8f,
+    0x02,0x03,0x67,0xf0,0x57,0x61,0x10,0x1f,0x04,0x13,0x05,0x14,0x03,0x12,0x20,0x21,
+    0x22,0x5d,0x5e,0x5f,0x60,0x65,0x66,0x62,0x63,0x64,0x07,0x16,0x2c,0x09,0x07,0x07,
+    0x15,0x07,0x50,0x57,0x06,0x00,0x3d,0x1e,0xc0,0x6e,0x03,0x0c,0x00,0x20,0x00,0xb8,
+    0x3c,0x20,0x00,0x80,0x01,0x02,0x03,0x04,0x67,0xd8,0x5d,0xc4,0x01,0x78,0x80,0x03,
+    0x83,0x5f,0x00,0x00,0xe2,0x00,0xeb,0xe3,0x05,0xc3,0x01,0xe3,0x06,0x0d,0x01,0xe5,
+    0x0e,0x5f,0x60,0x61,0x65,0xe4,0x0f,0x00,0x00,0x03,0xec,0x01,0x46,0xd0,0x00,0x44,
+    0x4b,0x5d,0x86,0x5e,0x56,0x9e,0x8e,0x08,0xe8,0x00,0x30,0xf2,0x70,0x5a,0x80,0xb0,
+    0x58,0x8a,0x00,0xba,0xa8,0x42,0x00,0x00,0x1e,0x00,0x00,0x00,0x00,0x00,0x00,0x07,
+};
+
+/* A/V receiver, many short audio descriptors, SPA 2.1.0.0, HF-VSDB */
+static const uint8 Edid_avr_audio[256] = {
+    0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x3d,0xcb,0x30,0x00,0x01,0x00,0x00,0x00,
+    0x1e,0x19,0x01,0x03,0x80,0x00,0x00,0x78,0x0a,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0x20,0x00,0x00,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,0x01,
+    0x01,0x01,0x01,0x01,0x01,0x01,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,
+    0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,
+    0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x00,0x00,0x00,0xfc,0x00,0x54,
+    0x58,0x2d,0x4e,0x52,0x36,0x34,0x36,0x0a,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xfd,
+    0x00,0x17,0x3d,0x0f,0x88,0x3c,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x01,0x3b,
+    0x02,0x03,0x3f,0xf0,0x4b,0x90,0x04,0x03,0x05,0x10,0x1f,0x20,0x22,0x5f,0x60,0x61,
+    0x38,0x0f,0x7f,0x07,0x15,0x07,0x50,0x3e,0x1e,0xc0,0x4d,0x02,0x00,0x57,0x06,0x03,
+    0x5f,0x7e,0x01,0x67,0x7e,0x03,0x35,0x07,0x48,0x83,0x4f,0x00,0x00,0x69,0x03,0x0c,
+    0x00,0x21,0x00,0xb8,0x3c,0x00,0x00,0x67,0xd8,0x5d,0xc4,0x01,0x78,0x00,0x00,0x02,
+    0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,0x45,0x00,0x58,0x54,0x21,0x00,0x00,
+    0x1e,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x30,
+};
+
+/* EDID 1.4 monitor with short HDMI VSDB, no audio blocks */
+static const uint8 Edid_hdmi_monitor_1p4[256] = {
+    0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x04,0x72,0x97,0x04,0x78,0x56,0x34,0x12,
+    0x2c,0x1b,0x01,0x04,0xa5,0x3c,0x22,0x78,0x3a,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0x00,0x00,0x00,0xd1,0xc0,0xb3,0x00,0xa9,0xc0,0x95,0x00,0x81,0x80,
+    0x01,0x01,0x01,0x01,0x01,0x01,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,
+    0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x00,0x00,0x00,0xfd,0x00,0x30,0x90,0xff,
+    0xff,0x3c,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xfc,0x00,0x58,
+    0x46,0x32,0x37,0x30,0x48,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xff,
+    0x00,0x54,0x35,0x41,0x41,0x41,0x30,0x30,0x31,0x33,0x38,0x30,0x30,0x0a,0x01,0x0d,
+    0x02,0x03,0x11,0x70,0x44,0x90,0x04,0x03,0x01,0x67,0x03,0x0c,0x00,0x10,0x00,0x00,
+    0x3c,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,0x45,0x00,0x58,0x54,0x21,
+    0x00,0x00,0x1e,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3e,
+};
+
+/* HDMI 1.4 TV with both block checksums wrong */
+static const uint8 Edid_bad_checksum[256] = {
+    0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x4c,0x2d,0x2e,0x0b,0x00,0x0e,0x00,0x01,
+    0x14,0x16,0x01,0x03,0x80,0x66,0x39,0x78,0x0a,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0x23,0x08,0x00,0x81,0xc0,0x81,0x00,0x81,0x80,0x95,0x00,0xa9,0xc0,
+    0xb3,0x00,0x01,0x01,0x01,0x01,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,
+    0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,
+    0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x00,0x00,0x00,0xfd,0x00,0x18,
+    0x4b,0x1a,0x51,0x17,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xfc,
+    0x00,0x53,0x41,0x4d,0x53,0x55,0x4e,0x47,0x0a,0x20,0x20,0x20,0x20,0x20,0x01,0x91,
+    0x02,0x03,0x2d,0xf0,0x4b,0x90,0x1f,0x04,0x13,0x05,0x14,0x03,0x12,0x20,0x21,0x22,
+    0x26,0x09,0x07,0x07,0x15,0x07,0x50,0x6d,0x03,0x0c,0x00,0x10,0x00,0xb8,0x2d,0x20,
+    0xd0,0x0e,0x01,0x40,0x00,0x83,0x01,0x00,0x00,0xe3,0x05,0x03,0x01,0x02,0x3a,0x80,
+    0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,
+    0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,
+    0x1e,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xb5,
+};
+
+/* broken 00 ff .. ff 00 header */
+static const uint8 Edid_bad_header[256] = {
+    0x00,0x00,0xff,0xff,0xff,0xff,0x00,0x00,0x4c,0x2d,0x2e,0x0b,0x00,0x0e,0x00,0x01,
+    0x14,0x16,0x01,0x03,0x80,0x66,0x39,0x78,0x0a,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0x23,0x08,0x00,0x81,0xc0,0x81,0x00,0x81,0x80,0x95,0x00,0xa9,0xc0,
+    0xb3,0x00,0x01,0x01,0x01,0x01,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,
+    0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,
+    0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x00,0x00,0x00,0xfd,0x00,0x18,
+    0x4b,0x1a,0x51,0x17,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xfc,
+    0x00,0x53,0x41,0x4d,0x53,0x55,0x4e,0x47,0x0a,0x20,0x20,0x20,0x20,0x20,0x01,0xcb,
+    0x02,0x03,0x2d,0xf0,0x4b,0x90,0x1f,0x04,0x13,0x05,0x14,0x03,0x12,0x20,0x21,0x22,
+    0x26,0x09,0x07,0x07,0x15,0x07,0x50,0x6d,0x03,0x0c,0x00,0x10,0x00,0xb8,0x2d,0x20,
+    0xd0,0x0e,0x01,0x40,0x00,0x83,0x01,0x00,0x00,0xe3,0x05,0x03,0x01,0x02,0x3a,0x80,
+    0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,
+    0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,
+    0x1e,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x10,
+};
+
+/* extension count 1 but block 1 is blank */
+static const uint8 Edid_missing_extension[256] = {
+    0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x4c,0x2d,0x2e,0x0b,0x00,0x0e,0x00,0x01,
+    0x14,0x16,0x01,0x03,0x80,0x66,0x39,0x78,0x0a,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0x23,0x08,0x00,0x81,0xc0,0x81,0x00,0x81,0x80,0x95,0x00,0xa9,0xc0,
+    0xb3,0x00,0x01,0x01,0x01,0x01,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,
+    0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,
+    0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x00,0x00,0x00,0xfd,0x00,0x18,
+    0x4b,0x1a,0x51,0x17,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xfc,
+    0x00,0x53,0x41,0x4d,0x53,0x55,0x4e,0x47,0x0a,0x20,0x20,0x20,0x20,0x20,0x01,0xcb,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+};
+
+/* extension count 3, only block 1 available */
+static const uint8 Edid_extension_count_3[256] = {
+    0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x1e,0x6d,0x07,0x77,0x01,0x01,0x01,0x01,
+    0x01,0x1d,0x01,0x03,0x80,0xa0,0x5a,0x78,0x0a,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0x21,0x08,0x00,0x71,0x40,0x81,0xc0,0x81,0x80,0x81,0x00,0xa9,0xc0,
+    0xd1,0xc0,0x01,0x01,0x01,0x01,0x08,0xe8,0x00,0x30,0xf2,0x70,0x5a,0x80,0xb0,0x58,
+    0x8a,0x00,0xba,0xa8,0x42,0x00,0x00,0x1e,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,
+    0x58,0x2c,0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x00,0x00,0x00,0xfd,0x00,0x18,
+    0x78,0x1e,0xff,0x77,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xfc,
+    0x00,0x4c,0x47,0x20,0x54,0x56,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x03,0x8d,
+    0x02,0x03,0x67,0xf0,0x57,0x61,0x10,0x1f,0x04,0x13,0x05,0x14,0x03,0x12,0x20,0x21,
+    0x22,0x5d,0x5e,0x5f,0x60,0x65,0x66,0x62,0x63,0x64,0x07,0x16,0x2c,0x09,0x07,0x07,
+    0x15,0x07,0x50,0x57,0x06,0x00,0x3d,0x1e,0xc0,0x6e,0x03,0x0c,0x00,0x20,0x00,0xb8,
+    0x3c,0x20,0x00,0x80,0x01,0x02,0x03,0x04,0x67,0xd8,0x5d,0xc4,0x01,0x78,0x80,0x03,
+    0x83,0x5f,0x00,0x00,0xe2,0x00,0xeb,0xe3,0x05,0xc3,0x01,0xe3,0x06,0x0d,0x01,0xe5,
+    0x0e,0x5f,0x60,0x61,0x65,0xe4,0x0f,0x00,0x00,0x03,0xec,0x01,0x46,0xd0,0x00,0x44,
+    0x4b,0x5d,0x86,0x5e,0x56,0x9e,0x8e,0x08,0xe8,0x00,0x30,0xf2,0x70,0x5a,0x80,0xb0,
+    0x58,0x8a,0x00,0xba,0xa8,0x42,0x00,0x00,0x1e,0x00,0x00,0x00,0x00,0x00,0x00,0x07,
+};
+
+/* cea dtd offset 0x7f, data blocks run into the checksum */
+static const uint8 Edid_dtd_offset_overrun[256] = {
+    0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x4c,0x2d,0x2e,0x0b,0x00,0x0e,0x00,0x01,
+    0x14,0x16,0x01,0x03,0x80,0x66,0x39,0x78,0x0a,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0x23,0x08,0x00,0x81,0xc0,0x81,0x00,0x81,0x80,0x95,0x00,0xa9,0xc0,
+    0xb3,0x00,0x01,0x01,0x01,0x01,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,
+    0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,
+    0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x00,0x00,0x00,0xfd,0x00,0x18,
+    0x4b,0x1a,0x51,0x17,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xfc,
+    0x00,0x53,0x41,0x4d,0x53,0x55,0x4e,0x47,0x0a,0x20,0x20,0x20,0x20,0x20,0x01,0xcb,
+    0x02,0x03,0x7f,0xf0,0x4b,0x90,0x1f,0x04,0x13,0x05,0x14,0x03,0x12,0x20,0x21,0x22,
+    0x26,0x09,0x07,0x07,0x15,0x07,0x50,0x6d,0x03,0x0c,0x00,0x10,0x00,0xb8,0x2d,0x20,
+    0xd0,0x0e,0x01,0x40,0x00,0x83,0x01,0x00,0x00,0xe3,0x05,0x03,0x01,0x02,0x3a,0x80,
+    0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,
+    0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,
+    0x1e,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xbe,
+};
+
+/* cea dtd offset 0, no data block collection */
+static const uint8 Edid_dtd_offset_zero[256] = {
+    0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x4c,0x2d,0x2e,0x0b,0x00,0x0e,0x00,0x01,
+    0x14,0x16,0x01,0x03,0x80,0x66,0x39,0x78,0x0a,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0x23,0x08,0x00,0x81,0xc0,0x81,0x00,0x81,0x80,0x95,0x00,0xa9,0xc0,
+    0xb3,0x00,0x01,0x01,0x01,0x01,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,
+    0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,
+    0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x00,0x00,0x00,0xfd,0x00,0x18,
+    0x4b,0x1a,0x51,0x17,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xfc,
+    0x00,0x53,0x41,0x4d,0x53,0x55,0x4e,0x47,0x0a,0x20,0x20,0x20,0x20,0x20,0x01,0xcb,
+    0x02,0x03,0x00,0xf0,0x4b,0x90,0x1f,0x04,0x13,0x05,0x14,0x03,0x12,0x20,0x21,0x22,
+    0x26,0x09,0x07,0x07,0x15,0x07,0x50,0x6d,0x03,0x0c,0x00,0x10,0x00,0xb8,0x2d,0x20,
+    0xd0,0x0e,0x01,0x40,0x00,0x83,0x01,0x00,0x00,0xe3,0x05,0x03,0x01,0x02,0x3a,0x80,
+    0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,
+    0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,
+    0x1e,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x3d,
+};
+
+/* first data block claims 31 bytes, spilling over its neighbours */
+static const uint8 Edid_block_length_overrun[256] = {
+    0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x1e,0x6d,0x07,0x77,0x01,0x01,0x01,0x01,
+    0x01,0x1d,0x01,0x03,0x80,0xa0,0x5a,0x78,0x0a,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0x21,0x08,0x00,0x71,0x40,0x81,0xc0,0x81,0x80,0x81,0x00,0xa9,0xc0,
+    0xd1,0xc0,0x01,0x01,0x01,0x01,0x08,0xe8,0x00,0x30,0xf2,0x70,0x5a,0x80,0xb0,0x58,
+    0x8a,0x00,0xba,0xa8,0x42,0x00,0x00,0x1e,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,
+    0x58,0x2c,0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x00,0x00,0x00,0xfd,0x00,0x18,
+    0x78,0x1e,0xff,0x77,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xfc,
+    0x00,0x4c,0x47,0x20,0x54,0x56,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x01,0x8f,
+    0x02,0x03,0x67,0xf0,0x5f,0x61,0x10,0x1f,0x04,0x13,0x05,0x14,0x03,0x12,0x20,0x21,
+    0x22,0x5d,0x5e,0x5f,0x60,0x65,0x66,0x62,0x63,0x64,0x07,0x16,0x2c,0x09,0x07,0x07,
+    0x15,0x07,0x50,0x57,0x06,0x00,0x3d,0x1e,0xc0,0x6e,0x03,0x0c,0x00,0x20,0x00,0xb8,
+    0x3c,0x20,0x00,0x80,0x01,0x02,0x03,0x04,0x67,0xd8,0x5d,0xc4,0x01,0x78,0x80,0x03,
+    0x83,0x5f,0x00,0x00,0xe2,0x00,0xeb,0xe3,0x05,0xc3,0x01,0xe3,0x06,0x0d,0x01,0xe5,
+    0x0e,0x5f,0x60,0x61,0x65,0xe4,0x0f,0x00,0x00,0x03,0xec,0x01,0x46,0xd0,0x00,0x44,
+    0x4b,0x5d,0x86,0x5e,0x56,0x9e,0x8e,0x08,0xe8,0x00,0x30,0xf2,0x70,0x5a,0x80,0xb0,
+    0x58,0x8a,0x00,0xba,0xa8,0x42,0x00,0x00,0x1e,0x00,0x00,0x00,0x00,0x00,0x00,0xff,
+};
+
+/* run of zero length data blocks */
+static const uint8 Edid_zero_length_blocks[256] = {
+    0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00,0x4c,0x2d,0x2e,0x0b,0x00,0x0e,0x00,0x01,
+    0x14,0x16,0x01,0x03,0x80,0x66,0x39,0x78,0x0a,0xee,0x91,0xa3,0x54,0x4c,0x99,0x26,
+    0x0f,0x50,0x54,0x23,0x08,0x00,0x81,0xc0,0x81,0x00,0x81,0x80,0x95,0x00,0xa9,0xc0,
+    0xb3,0x00,0x01,0x01,0x01,0x01,0x02,0x3a,0x80,0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,
+    0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,
+    0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x00,0x00,0x00,0xfd,0x00,0x18,
+    0x4b,0x1a,0x51,0x17,0x00,0x0a,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0x00,0x00,0xfc,
+    0x00,0x53,0x41,0x4d,0x53,0x55,0x4e,0x47,0x0a,0x20,0x20,0x20,0x20,0x20,0x01,0xcb,
+    0x02,0x03,0x2d,0xf0,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x26,0x09,0x07,0x07,0x15,0x07,0x50,0x6d,0x03,0x0c,0x00,0x10,0x00,0xb8,0x2d,0x20,
+    0xd0,0x0e,0x01,0x40,0x00,0x83,0x01,0x00,0x00,0xe3,0x05,0x03,0x01,0x02,0x3a,0x80,
+    0x18,0x71,0x38,0x2d,0x40,0x58,0x2c,0x45,0x00,0x58,0x54,0x21,0x00,0x00,0x1e,0x01,
+    0x1d,0x00,0x72,0x51,0xd0,0x1e,0x20,0x6e,0x28,0x55,0x00,0x58,0x54,0x21,0x00,0x00,
+    0x1e,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xb2,
+};
+
+/* erased eeprom, every byte 0xff */
+static const uint8 Edid_all_ff[256] = {
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+    0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,0xff,
+};
+
+/* no edid read, every byte 0 */
+static const uint8 Edid_all_zero[256] = {
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+    0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,
+};
+
+const EdidCorpusEntry EdidCorpus[] = {
+    /* name, malformed, edid, extensions, spa location, spa */
+    { "dvi_monitor_1p3", 0, Edid_dvi_monitor_1p3, 1, 0xb4, {0x10,0x00} },
+    { "hdmi14_tv", 0, Edid_hdmi14_tv, 1, 0x9f, {0x10,0x00} },
+    { "hdmi20_4k_hdr_tv", 0, Edid_hdmi20_4k_hdr_tv, 1, 0xb1, {0x20,0x00} },
+    { "avr_audio", 0, Edid_avr_audio, 1, 0xa6, {0x21,0x00} },
+    { "hdmi_monitor_1p4", 0, Edid_hdmi_monitor_1p4, 1, 0xa0, {0x10,0x00} },
+    { "bad_checksum", 1, Edid_bad_checksum, 1, 0x9f, {0x10,0x00} },
+    { "bad_header", 1, Edid_bad_header, 1, 0xb4, {0x10,0x00} },
+    { "missing_extension", 1, Edid_missing_extension, 1, 0xb4, {0x10,0x00} },
+    { "extension_count_3", 1, Edid_extension_count_3, 1, 0xb1, {0x20,0x00} },
+    { "dtd_offset_overrun", 1, Edid_dtd_offset_overrun, 1, 0x9f, {0x10,0x00} },
+    { "dtd_offset_zero", 1, Edid_dtd_offset_zero, 1, 0x9f, {0x10,0x00} },
+    { "block_length_overrun", 1, Edid_block_length_overrun, 1, 0xb3, {0x10,0x00} },
+    { "zero_length_blocks", 1, Edid_zero_length_blocks, 1, 0xb4, {0x10,0x00} },
+    { "all_ff", 1, Edid_all_ff, 1, 0xb4, {0x10,0x00} },
+    { "all_zero", 1, Edid_all_zero, 1, 0xb4, {0x10,0x00} },
+};
+
+const uint16 EdidCorpusSize = sizeof(EdidCorpus)/sizeof(EdidCorpus[0]);
@@ -0,0 +1,309 @@
+/**
+ * @file edid_harness.c
+ *
+ * @brief host side test and benchmark of the edid merge engine
+ *
+ * every corpus edid goes through the same steps as AvEdidPortManage():
+ * AvEdidFuncMerge, AvEdidFuncCheckSum and the SPA lookup, once as the only
+ * sink and once merged with a second sink. The merged edid is checked for
+ * header, block checksums, extension count, data block layout and SPA, and
+ * the time of a merge is reported per edid.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <time.h>
+#include "edid_harness.h"
+
+/* sink merged with every corpus edid in the second pass */
+#define HarnessPairName      "hdmi20_4k_hdr_tv"
+
+typedef struct
+{
+    uint8  Extensions;
+    uint8  SpaLocation;
+    uint8  Spa[2];
+    double UsPerMerge;
+} HarnessResult;
+
+static AvEdidReg HarnessReg;
+static uint8 HarnessIn[256];
+static uint8 HarnessSink[256];
+static uint8 HarnessOut[256];
+static const char *HarnessError;
+
+/**
+ * @brief  find the SPA of the hdmi vsdb, same walk as KfunFindCecSPAFromEdid
+ * @return offset of the SPA, EdidNoSpa if there is none
+ * @note   the driver copy lives in the kapi layer, which does not build on the host
+ */
+static uint8 HarnessFindSpa(const uint8 *Edid, uint8 *Spa)
+{
+    uint16 Offset = 0x84;
+    uint16 DtdStart = 0;
+    uint8  Len = 0;
+
+    Spa[0] = 0xff;
+    Spa[1] = 0xff;
+    if((Edid[0x7e] == 0) || (Edid[0x80] != 0x02) || (Edid[0x81] != 0x03))
+        return EdidNoSpa;
+    DtdStart = (Edid[0x82] >= 4) ? (0x80 + Edid[0x82]) : 0xff;
+    while(Offset < DtdStart)
+    {
+        Len = Edid[Offset] & 0x1f;
+        if((Edid[Offset] & 0xe0) == 0x60)
+        {
+            if((Edid[Offset+1] != 0x03) || (Edid[Offset+2] != 0x0c) || (Edid[Offset+3] != 0x00))
+                return EdidNoSpa;
+            Spa[0] = Edid[Offset+4];
+            Spa[1] = Edid[Offset+5];
+            return (uint8)(Offset + 4);
+        }
+        if(Len == 0)
+            return EdidNoSpa;
+        Offset = Offset + Len + 1;
+    }
+    return EdidNoSpa;
+}
+
+/**
+ * @brief  check what every merged edid must hold, whatever the sinks sent
+ * @return 1 if the edid is sane, else 0 with HarnessError set
+ */
+static int HarnessCheckStructure(const uint8 *Edid)
+{
+    static const uint8 Header[8] = {0x00,0xff,0xff,0xff,0xff,0xff,0xff,0x00};
+    uint8  Sum = 0;
+    uint16 i = 0;
+    uint16 Offset = 0;
+    uint16 DtdStart = 0;
+
+    if(memcmp(Edid, Header, 8) != 0)
+    {
+        HarnessError = "bad header";
+        return 0;
+    }
+    for(i=0; i<128; i++)
+        Sum = Sum + Edid[i];
+    if(Sum != 0)
+    {
+        HarnessError = "block 0 checksum";
+        return 0;
+    }
+    if(Edid[0x7e] > 1)
+    {
+        HarnessError = "more extensions than the 256 byte edid ram holds";
+        return 0;
+    }
+    if(Edid[0x7e] == 0)
+        return 1;
+
+    for(i=128, Sum=0; i<256; i++)
+        Sum = Sum + Edid[i];
+    if(Sum != 0)
+    {
+        HarnessError = "block 1 checksum";
+        return 0;
+    }
+    if((Edid[0x80] != 0x02) || (Edid[0x81] != 0x03))
+    {
+        HarnessError = "block 1 is not a cea-861 version 3 extension";
+        return 0;
+    }
+    /* data blocks must end exactly where the detailed timings start */
+    if(Edid[0x82] == 0)
+        return 1;
+    if((Edid[0x82] < 4) || (Edid[0x82] > 127))
+    {
+        HarnessError = "dtd offset out of range";
+        return 0;
+    }
+    DtdStart = 0x80 + Edid[0x82];
+    for(Offset=0x84; Offset<DtdStart; Offset=Offset+(Edid[Offset]&0x1f)+1)
+    {
+        if((Edid[Offset] & 0x1f) == 0)
+        {
+            HarnessError = "zero length data block";
+            return 0;
+        }
+    }
+    if(Offset != DtdStart)
+    {
+        HarnessError = "data block runs over the dtd offset";
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief  one merge as AvEdidPortManage does it
+ * @note   Second is NULL for a single sink, the merge then runs against a blank edid
+ */
+static void HarnessMerge(const uint8 *First, const uint8 *Second)
+{
+    AvEdidFuncParamInit(&HarnessReg);
+    memcpy(HarnessIn, First, 256);
+    if(Second != NULL)
+        memcpy(HarnessSink, Second, 256);
+    else
+        memset(HarnessSink, 0, 256);
+    memset(HarnessOut, 0, 256);
+    AvEdidFuncMerge(&HarnessReg, HarnessIn, HarnessSink, HarnessOut);
+    AvEdidFuncCheckSum(HarnessOut);
+}
+
+static double HarnessNow(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e6 + (double)ts.tv_nsec / 1e3;
+}
+
+/**
+ * @brief  merge, check the structure and time the merge
+ * @return 1 if the merged edid is sane, else 0
+ */
+static int HarnessRun(const uint8 *First, const uint8 *Second, uint32 Iterations, HarnessResult *Result)
+{
+    double Start = 0;
+    uint32 i = 0;
+
+    HarnessError = NULL;
+    HarnessMerge(First, Second);
+    Result->Extensions = HarnessOut[0x7e];
+    Result->SpaLocation = HarnessFindSpa(HarnessOut, Result->Spa);
+    if(HarnessCheckStructure(HarnessOut) == 0)
+        return 0;
+
+    Start = HarnessNow();
+    for(i=0; i<Iterations; i++)
+        HarnessMerge(First, Second);
+    Result->UsPerMerge = Iterations ? (HarnessNow() - Start) / Iterations : 0;
+    return 1;
+}
+
+static void HarnessDump(const char *Name, const uint8 *Edid)
+{
+    uint16 i = 0;
+
+    printf("merged edid of %s:\n", Name);
+    for(i=0; i<256; i++)
+        printf("%02x%s", Edid[i], ((i & 0x0f) == 0x0f) ? "\n" : " ");
+}
+
+static void HarnessUsage(const char *Prog)
+{
+    fprintf(stderr, "usage: %s [-n iterations] [-d] [-r]\n"
+                    "  -n  merges timed per edid, default 2000\n"
+                    "  -d  dump the merged edid of every failing entry\n"
+                    "  -r  print the measured expectations in corpus table form\n", Prog);
+}
+
+int main(int argc, char **argv)
+{
+    const EdidCorpusEntry *Entry = NULL;
+    const uint8 *Pair = NULL;
+    HarnessResult Single, Paired;
+    uint32 Iterations = 2000;
+    uint8 Dump = 0;
+    uint8 Record = 0;
+    int Failures = 0;
+    int Ok = 0;
+    int opt = 0;
+    uint16 i = 0;
+
+    while((opt = getopt(argc, argv, "n:dr")) != -1)
+    {
+        switch(opt)
+        {
+            case 'n':
+                Iterations = (uint32)strtoul(optarg, NULL, 0);
+                break;
+            case 'd':
+                Dump = 1;
+                break;
+            case 'r':
+                Record = 1;
+                break;
+            default:
+                HarnessUsage(argv[0]);
+                return 2;
+        }
+    }
+
+    for(i=0; i<EdidCorpusSize; i++)
+    {
+        if(strcmp(EdidCorpus[i].Name, HarnessPairName) == 0)
+            Pair = EdidCorpus[i].Edid;
+    }
+    if(Pair == NULL)
+    {
+        fprintf(stderr, "corpus has no %s entry\n", HarnessPairName);
+        return 2;
+    }
+
+    printf("%-22s %-9s %4s %-12s %10s %10s  %s\n",
+           "edid", "kind", "ext", "spa at:val", "us/merge", "us/pair", "result");
+    for(i=0; i<EdidCorpusSize; i++)
+    {
+        Entry = &EdidCorpus[i];
+        memset(&Single, 0, sizeof(Single));
+        memset(&Paired, 0, sizeof(Paired));
+
+        /* single sink: structure and the recorded expectations */
+        Ok = HarnessRun(Entry->Edid, NULL, Iterations, &Single);
+        if(Ok && (Record == 0))
+        {
+            if(Single.Extensions != Entry->ExpectExtensions)
+            {
+                HarnessError = "extension count";
+                Ok = 0;
+            }
+            else if((Single.SpaLocation != Entry->ExpectSpaLocation) ||
+                    ((Single.SpaLocation != EdidNoSpa) &&
+                     ((Single.Spa[0] != Entry->ExpectSpa[0]) || (Single.Spa[1] != Entry->ExpectSpa[1]))))
+            {
+                HarnessError = "spa location or value";
+                Ok = 0;
+            }
+        }
+        if(Ok == 0)
+        {
+            printf("%-22s %-9s %4u %02x:%02x%02x %10s %10s  FAIL single: %s\n",
+                   Entry->Name, Entry->Malformed ? "malformed" : "sink",
+                   Single.Extensions, Single.SpaLocation, Single.Spa[0], Single.Spa[1], "-", "-", HarnessError);
+            if(Dump)
+                HarnessDump(Entry->Name, HarnessOut);
+            Failures++;
+            continue;
+        }
+
+        /* second sink: structure only, the merge result depends on both */
+        Ok = HarnessRun(Entry->Edid, Pair, Iterations, &Paired);
+        if(Ok == 0)
+        {
+            printf("%-22s %-9s %4u %02x:%02x%02x %10.2f %10s  FAIL paired: %s\n",
+                   Entry->Name, Entry->Malformed ? "malformed" : "sink",
+                   Single.Extensions, Single.SpaLocation, Single.Spa[0], Single.Spa[1],
+                   Single.UsPerMerge, "-", HarnessError);
+            if(Dump)
+                HarnessDump(Entry->Name, HarnessOut);
+            Failures++;
+            continue;
+        }
+
+        if(Record)
+            printf("    { \"%s\", %u, Edid_%s, %u, 0x%02x, {0x%02x,0x%02x} },\n",
+                   Entry->Name, Entry->Malformed, Entry->Name,
+                   Single.Extensions, Single.SpaLocation, Single.Spa[0], Single.Spa[1]);
+        else
+            printf("%-22s %-9s %4u %02x:%02x%02x %10.2f %10.2f  ok\n",
+                   Entry->Name, Entry->Malformed ? "malformed" : "sink",
+                   Single.Extensions, Single.SpaLocation, Single.Spa[0], Single.Spa[1],
+                   Single.UsPerMerge, Paired.UsPerMerge);
+    }
+
+    printf("%u edids, %d failed\n", EdidCorpusSize, Failures);
+    return Failures ? 1 : 0;
+}
@@ -0,0 +1,28 @@
+/**
+ * @file edid_harness.h
+ *
+ * @brief host side harness running the edid merge engine over a corpus of sink edids
+ */
+#ifndef __edid_harness_h
+#define __edid_harness_h
+
+#include "av_config.h"
+#include "av_edid_manage.h"
+
+/* SPA location reported when the merged edid carries no hdmi vsdb */
+#define EdidNoSpa            0x01
+
+typedef struct
+{
+    const char  *Name;
+    uint8        Malformed;         /* 1 for edids no sink should send, only robustness is checked */
+    const uint8 *Edid;
+    uint8        ExpectExtensions;  /* extension count of the merged edid */
+    uint8        ExpectSpaLocation; /* offset of the SPA in the merged edid, EdidNoSpa if none */
+    uint8        ExpectSpa[2];
+} EdidCorpusEntry;
+
+extern const EdidCorpusEntry EdidCorpus[];
+extern const uint16 EdidCorpusSize;
+
+#endif
@@ -6,20 +6,103 @@
 #include "gsv2k11_tables.h"
 #include <linux/module.h>
 
+/* Rx Ksv Fifo: 5 byte Ksvs packed over HDCP_MAP_SEL pages of 128 bytes from 0x80 */
+#define Gsv2k11KsvListMax      127
+#define Gsv2k11KsvPageSize     128
+#define Gsv2k11KsvHashSize     256  /* uint8 probe slots wrap around it */
+
+#if AvEnableEqPresets
+/* eq parameter plans, in the order the eq search escalates through them */
+#define Gsv2k11EqPlanFast          0
+#define Gsv2k11EqPlanEnhancedFirst 1
+#define Gsv2k11EqPlanEnhanced      2
+
+/* eq plan that found the eye for a source at a lane frequency band */
+typedef struct
+{
+    uint32 SourceKey;            /* spd fingerprint of the source, 0 if unknown */
+    uint8  Band;
+    uint8  Plan;
+    uint8  Valid;
+}   Gsv2k11EqPreset;
+#endif
+
+/* sources without MASKB, acknowledged by AvUapiGetInterrupt and latched for the FSM */
+#define Gsv2k11LatchPllLockDet     0x01
+#define Gsv2k11LatchTxHpd          0x02
+#define Gsv2k11LatchCecTxReady     0x04
+#define Gsv2k11LatchCecArbLost     0x08
+#define Gsv2k11LatchCecTimeout     0x10
+#define Gsv2k11LatchCecAll         0x1C
+
 typedef struct
 {
     /* The Port CP Core is connected */
     AvPort *Cp1CoreOccupied;
+    /* Gsv2k11Latch* bits fired since the FSM last looked at them */
+    uint8  IntLatch;
 #if AvEdidStoredInRam
     uint8  TxBEdidRam[AvEdidMaxSize];
 #endif
+#if AvEdidRamShadow
+    /* content of the two Rx Edid Ram pages, only trusted when valid */
+    uint8  RxEdidRamValid[2];
+    uint8  RxEdidRam[2][256];
+    uint8  RxEdidSpaLoc;
+#endif
+#if (AvEnableSinkEdidCache && (AvEdidStoredInRam == 0))
+    /* last valid edid read from the TxB sink */
+    uint8  TxBSinkEdidValid;
+    uint8  TxBSinkEdid[AvEdidMaxSize];
+#endif
+#if AvEnableKsvIndex
+    /* host copy of the Rx Ksv Fifo, hashed for lookups without i2c */
+    uint8  RxKsvCount;
+    uint8  RxKsvList[Gsv2k11KsvListMax*5];
+    uint8  RxKsvHash[Gsv2k11KsvHashSize]; /* list position + 1, 0 if free */
+#endif
+#if AvEnableEqPresets
+    Gsv2k11EqPreset RxEqPreset[AvEqPresetEntries];
+    uint8  RxEqPresetNext;       /* next entry to replace */
+    uint8  RxEqPlan;             /* plan of the eq round running */
+    uint8  RxEqTrial;            /* the round running was started from a preset */
+    uint8  RxEqLearnPending;     /* eye found before the spd of the source was read */
+    uint32 RxSourceKey;          /* spd fingerprint of the connected source, 0 if not read yet */
+#endif
 }   Resource;
 
-static Resource InternalResource;
-
-#define FindCp1Mode(port)      (InternalResource.Cp1CoreOccupied)
+/* allocated per device from its static buffer, hung on device->extension */
+#define Gsv2k11Resource(port)  ((Resource *)((port)->device->extension))
+#define FindCp1Mode(port)      (Gsv2k11Resource(port)->Cp1CoreOccupied)
+#define IntLatch(port)         (Gsv2k11Resource(port)->IntLatch)
 #if AvEdidStoredInRam
-#define TxBEdidRam(port)       (InternalResource.TxBEdidRam)
+#define TxBEdidRam(port)       (Gsv2k11Resource(port)->TxBEdidRam)
+#endif
+#if AvEdidRamShadow
+#define RxEdidRamValid(port)   (Gsv2k11Resource(port)->RxEdidRamValid)
+#define RxEdidRam(port)        (Gsv2k11Resource(port)->RxEdidRam)
+#define RxEdidSpaLoc(port)     (Gsv2k11Resource(port)->RxEdidSpaLoc)
+/* unchanged bytes bridged inside one burst, cheaper than a new i2c transfer */
+#define Gsv2k11EdidBurstGap    4
+#endif
+#if AvEnableKsvIndex
+#define RxKsvCount(port)       (Gsv2k11Resource(port)->RxKsvCount)
+#define RxKsvList(port)        (Gsv2k11Resource(port)->RxKsvList)
+#define RxKsvHash(port)        (Gsv2k11Resource(port)->RxKsvHash)
+#endif
+#if AvEnableEqPresets
+#define RxEqPreset(port)       (Gsv2k11Resource(port)->RxEqPreset)
+#define RxEqPresetNext(port)   (Gsv2k11Resource(port)->RxEqPresetNext)
+#define RxEqPlan(port)         (Gsv2k11Resource(port)->RxEqPlan)
+#define RxEqTrial(port)        (Gsv2k11Resource(port)->RxEqTrial)
+#define RxEqLearnPending(port) (Gsv2k11Resource(port)->RxEqLearnPending)
+#define RxSourceKey(port)      (Gsv2k11Resource(port)->RxSourceKey)
+#endif
+#if (AvEnableSinkEdidCache && (AvEdidStoredInRam == 0))
+#define TxBSinkEdidValid(port) (Gsv2k11Resource(port)->TxBSinkEdidValid)
+#define TxBSinkEdid(port)      (Gsv2k11Resource(port)->TxBSinkEdid)
+/* header, vendor and product id, serial number and manufacture date */
+#define Gsv2k11SinkEdidIdSize  18
 #endif
 
 #define Gsv2k11SetVideoPacketFlag(BitName) \
@@ -51,6 +134,14 @@ static Resource InternalResource;
 #define Gsv2k11IntptClr(func) \
             GSV2K11_INT_set_RX1_##func##_CLEAR(port,         1);
 
+#define Gsv2k11IntptMask(func, value) \
+            GSV2K11_INT_set_RX1_##func##_MASKB(port,         value);
+
+#define Gsv2k11IntptEvent(func, event) \
+            GSV2K11_INT_get_RX1_##func##_INT_ST(port,         &value);\
+            if(value == 1)\
+                *IntEvents = *IntEvents | event;
+
 /* local functions */
 void Gsv2k11GetRx5VStatus(pin AvPort *port);
 void Gsv2k11EnableRxHpa(pin AvPort *port);
@@ -58,6 +149,9 @@ void Gsv2k11DisableRxHpa(pin AvPort *port);
 void Gsv2k11ToggleTxHpd(pin AvPort *port);
 void Gsv2k11ToggleTmdsOut(AvPort *port, uint8 Enable);
 void Gsv2k11RxManualEQUpdate(AvPort *port, uint8 DefaultEQEnable);
+#if AvEnableEqPresets
+void Gsv2k11RxEqSourceUpdate(pin AvPort *port, uint8 *Content);
+#endif
 void Gsv2k11SetTxHdcpVersion(pin AvPort *port, HdcpTxSupportType HdmiStyle, uint8 ForceUpdate);
 void Gsv2k11UpdateRxCdrBandWidth(pin AvPort *port);
 uint8 Gsv2k11TxScdcAction(pin AvPort *port, uint8 WriteEnable, uint8 DevAddr, uint8 RegAddr, uint8 Value);
@@ -80,7 +174,7 @@ void Gsv2k11CpCscManage(pin AvPort *port, AvVideoCs VarInCs, AvVideoCs VarOutCs)
  */
 uapi AvRet ImplementUapi(Gsv2k11, AvUapiInitDevice(pin AvDevice *device))
 {
-    //Resource *InternalResource;
+    Resource *InternalResource = NULL;
     uint32 i = 0;
     uint32 k = 0;
     uint32 DefaultMapAddress;
@@ -90,6 +184,7 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiInitDevice(pin AvDevice *device))
     DefaultMapAddress = gsv2k11Dev->DeviceAddress;
 
     /* reset device */
+    AvHalI2cSnapshotDrop(GSV2K11_PRIM_MAP_ADDR(port));
     GSV2K11_PRIM_set_MAIN_RST(port, 0);
     GSV2K11_PRIM_set_MAIN_RST(port, 1);
     for(i=0; i<100; i++)
@@ -110,9 +205,18 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiInitDevice(pin AvDevice *device))
     for(k=0; Gsv2k11EqTable[k]!=0xFF; k=k+2)
         AvHalI2cWriteField8(GSV2K11_RXLN_MAP_ADDR(port),Gsv2k11EqTable[k],0xFF,0,Gsv2k11EqTable[k+1]);
 
-    //AvUapiAllocateMemory(sizeof(Resource), (uint32 *)&InternalResource);
-    device->extension = &InternalResource;
+    if(device->extension == NULL)
+    {
+        if(AvUapiAllocateMemory(device, sizeof(Resource), (uint64 *)&InternalResource) != AvOk)
+            return AvError;
+        device->extension = InternalResource;
+    }
     FindCp1Mode(port) = NULL;
+#if AvEdidRamShadow
+    /* Edid Ram content is unknown after reset */
+    RxEdidRamValid(port)[0] = 0;
+    RxEdidRamValid(port)[1] = 0;
+#endif
 
 #if Gsv2k11MuxMode
     GSV2K11_SEC_set_TXPORT_A_SRC_SEL(port, 2);
@@ -122,6 +226,206 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiInitDevice(pin AvDevice *device))
     return AvOk;
 }
 
+/**
+ * @brief  device resume function
+ * @return AvOk if success
+ * @note   register content may be lost during suspend, drop its shadows
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiResumeDevice(pio AvDevice *device))
+{
+    AvPort *port = (AvPort *)device->port;
+
+    AvHalI2cSnapshotDrop(GSV2K11_PRIM_MAP_ADDR(port));
+    if(device->extension == NULL)
+        return AvOk;
+#if AvEdidRamShadow
+    RxEdidRamValid(port)[0] = 0;
+    RxEdidRamValid(port)[1] = 0;
+#endif
+#if AvEnableKsvIndex
+    /* the Rx Ksv Fifo is not kept, repeater authentication fills it again */
+    RxKsvCount(port) = 0;
+    AvMemset(RxKsvHash(port), 0, Gsv2k11KsvHashSize);
+#endif
+    return AvOk;
+}
+
+#if AvEnableFastResume
+/**
+ * @brief  device restore function
+ * @return AvOk if success
+ * @note   the bsp wrote the cached registers back, the maps it does not
+ * @note   cache are programmed here from what the package still holds
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiRestoreDevice(pio AvDevice *device))
+{
+    AvRet ret = AvOk;
+    AvPort *port = (AvPort *)device->port;
+    uint32 k = 0;
+    uint8 Page = 0;
+
+    AvHalI2cSnapshotDrop(GSV2K11_PRIM_MAP_ADDR(port));
+
+    /* rx lane maps */
+    for(k=0; Gsv2k11EqTable[k]!=0xFF; k=k+2)
+        AvHalI2cWriteField8(GSV2K11_RXLN_MAP_ADDR(port),Gsv2k11EqTable[k],0xFF,0,Gsv2k11EqTable[k+1]);
+
+    if(device->extension == NULL)
+        return AvOk;
+#if AvEnableKsvIndex
+    /* the Rx Ksv Fifo is not written back, repeater authentication fills it again */
+    RxKsvCount(port) = 0;
+    AvMemset(RxKsvHash(port), 0, Gsv2k11KsvHashSize);
+#endif
+
+    /* rx edid ram, written back from its shadow so the source sees the same edid */
+    for(Page=0; Page<2; Page++)
+    {
+        if(RxEdidRamValid(port)[Page] == 0)
+            continue;
+        GSV2K11_RXRPT_set_RX_EDID_RAM_SEL(port, 0);
+        GSV2K11_RXRPT_set_RX_EDID_RAM_PAGE_SEL(port, Page);
+        if(AvHalI2cWriteMultiField(GSV2K11_HDMI_EDID_ADDR(port), 0, 256, RxEdidRam(port)[Page]) != AvOk)
+        {
+            RxEdidRamValid(port)[Page] = 0;
+            ret = AvError;
+        }
+    }
+    if(RxEdidRamValid(port)[0] != 0)
+    {
+#if (AvDontCareEdidSpa == 0)
+        GSV2K11_RXRPT_set_RX_EDID1_SPA_LOC_LSB(port, RxEdidSpaLoc(port));
+#endif
+        AvUapiRxEnableInternalEdid(port);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  check the link of a port after restore
+ * @return AvOk if the port is still connected as at suspend, else AvError
+ * @note   only raw status is read, the port content is left untouched
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiRestorePort(pio AvPort *port))
+{
+    uint8 value = 0;
+
+    switch(port->type)
+    {
+        case HdmiRx:
+            GSV2K11_INT_get_RXA_CABLE_DETECT_RAW_ST(port, &value);
+            break;
+        case HdmiTx:
+            GSV2K11_TXPHY_get_HPD_RAW_STATE(port, &value);
+            break;
+        default:
+            return AvOk;
+    }
+
+    return (value != 0) ? AvOk : AvError;
+}
+#endif
+
+/**
+ * @brief  device replay function
+ * @return AvOk if success
+ * @note   the init table entries the bsp does not restore, resets and
+ * @note   triggers among them, are written again in init order; called
+ * @note   before the bsp writes its cached registers back
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiReplayDevice(pio AvDevice *device))
+{
+    AvRet ret = AvOk;
+    Gsv2k11Device *gsv2k11Dev = (Gsv2k11Device *)device->specific;
+    uint32 DefaultMapAddress = gsv2k11Dev->DeviceAddress;
+    uint32 k = 0;
+
+    for(k=0; Gsv2k11InitTable[k]!=0xFF; k=k+3)
+    {
+        if(AvUapiRegisterVolatile(device, (Gsv2k11InitTable[k] << 8) | Gsv2k11InitTable[k+1]) == 0)
+            continue;
+        if(AvHalI2cWriteField8(DefaultMapAddress | Gsv2k11InitTable[k],Gsv2k11InitTable[k+1],0xFF,0,Gsv2k11InitTable[k+2]) != AvOk)
+            ret = AvError;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  tell whether a register is changed by the hardware
+ * @param  regAddress = map page in bits 15:8, register in bits 7:0
+ * @return 1 if the register must be read from the chip and not be restored
+ * @note   maps without volatile table entry are volatile as a whole, so are
+ * @note   the status blocks burst read by the snapshot
+ */
+uapi uint8 ImplementUapi(Gsv2k11, AvUapiRegisterVolatile(pin AvDevice *device, pin uint16 regAddress))
+{
+    uint8 page = (regAddress >> 8) & 0xFF;
+    uint8 reg = regAddress & 0xFF;
+    uint32 i = 0;
+    uint32 k = 0;
+
+#if AvEnableI2cSnapshot
+    for(k=0; Gsv2k11RxSnapshotTable[k]!=0xFF; k=k+3)
+    {
+        if((Gsv2k11RxSnapshotTable[k] == page) && (reg >= Gsv2k11RxSnapshotTable[k+1]) &&
+           (reg < (Gsv2k11RxSnapshotTable[k+1] + Gsv2k11RxSnapshotTable[k+2])))
+            return 1;
+    }
+#endif
+    for(k=0; Gsv2k11VolatileTable[k]!=0xFF; k=k+Gsv2k11VolatileTable[k+1]+2)
+    {
+        if(Gsv2k11VolatileTable[k] != page)
+            continue;
+        for(i=0; i<Gsv2k11VolatileTable[k+1]; i++)
+        {
+            if(Gsv2k11VolatileTable[k+2+i] == reg)
+                return 1;
+        }
+        return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief  tell whether reading a register has a side effect
+ * @param  regAddress = map page in bits 15:8, register in bits 7:0
+ * @return 1 if only the driver may read the register
+ */
+uapi uint8 ImplementUapi(Gsv2k11, AvUapiRegisterPrecious(pin AvDevice *device, pin uint16 regAddress))
+{
+    uint8 page = (regAddress >> 8) & 0xFF;
+    uint32 k = 0;
+
+    for(k=0; Gsv2k11PreciousTable[k]!=0xFF; k++)
+    {
+        if(Gsv2k11PreciousTable[k] == page)
+            return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief  burst read the status registers of a port
+ * @return AvOk: success
+ * @note   the port status getters are served from the snapshot until the
+ *         port update ends with AvHalI2cSnapshotDrop
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiSnapshotPort(pio AvPort *port))
+{
+#if AvEnableI2cSnapshot
+    uint8 k = 0;
+
+    if(port->type != HdmiRx)
+        return AvOk;
+    for(k=0; Gsv2k11RxSnapshotTable[k]!=0xFF; k=k+3)
+        AvHalI2cSnapshot(GSV2K11_PRIM_MAP_ADDR(port) | Gsv2k11RxSnapshotTable[k],
+                         Gsv2k11RxSnapshotTable[k+1], Gsv2k11RxSnapshotTable[k+2]);
+#endif
+    return AvOk;
+}
+
 /**
  * @brief  init rx port
  * @return AvOk: success
@@ -660,6 +964,11 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiTxGetStatus(pin AvPort *port))
         {
             case 5:
                 GSV2K11_INT_get_TXB_HPD_INTR_INT_ST(port, &NewValue);
+                if(IntLatch(port) & Gsv2k11LatchTxHpd)
+                {
+                    IntLatch(port) = IntLatch(port) & (~Gsv2k11LatchTxHpd);
+                    NewValue = 1;
+                }
                 if(NewValue == 1)
                 {
                     GSV2K11_INT_set_TXB_HPD_INTR_CLEAR(port, 1);
@@ -917,6 +1226,8 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiTxGetStatus(pin AvPort *port))
                     Packet[1] = 0x02;
                     Packet[2] = 0x0D;
                     Gsv2k11_TxSendAVInfoFrame(port, Packet, 1);
+                    /* written behind the forward path, it must not be skipped as unchanged */
+                    KfunTxClearPacketSign(port);
                 }
             }
             if(port->content.tx->InfoReady >= TxVideoManageThreshold)
@@ -1593,6 +1904,7 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiDisconnectPort(pin AvPort *port))
         Gsv2k11DisableRxHpa(port);
         port->content.rx->Hpd = AV_HPD_LOW;
         port->content.rx->HpdDelayExpire = 0;
+        AvHalGetMilliSecond(&port->content.rx->HpdLowStart);
         /* 2. Clear Rx's Pointer */
         port->core.HdmiCore = -1;
     }
@@ -1714,6 +2026,9 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxGetVideoPacketStatus(pin AvPort *port,
 
     if(((MapData[0] & 0x01) != 0) || ((MapData[15] & 0x01) != 0))
         Intpt->AvIfValid = 1;
+#if AvEnablePacketIntGate
+    /* PKTDET/PKT_NEW latch every avi change, no need to poll the body checksum */
+#else
     else
     {
         if((port->content.video->AvailableVideoPackets & AV_BIT_AV_INFO_FRAME) != 0)
@@ -1723,6 +2038,7 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxGetVideoPacketStatus(pin AvPort *port,
                 Intpt->AvIfValid = 1;
         }
     }
+#endif
     if(((MapData[1] & 0x01) != 0) || ((MapData[16] & 0x01) != 0))
         Intpt->SpdValid = 1;
     if(((MapData[13] & 0x10) != 0) || ((MapData[41] & 0x10) != 0))
@@ -2446,11 +2762,177 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxHdmiClearKsvFifo(pio AvPort *port))
         AvHalI2cWriteMultiField(GSV2K11_RXRPT_MAP_ADDR(port), StartReg+64, 64, ZeroBuf);
     }
     GSV2K11_RXRPT_set_HDCP_MAP_SEL(port, 0);
+#if AvEnableKsvIndex
+    RxKsvCount(port) = 0;
+    AvMemset(RxKsvHash(port), 0, Gsv2k11KsvHashSize);
+#endif
     AvUapiOutputDebugMessage("Clear Rx KSV Fifo");
 
     return ret;
 }
 
+#if AvEnableKsvIndex
+/* hash slot of a Ksv, Ksvs have 20 random bits set so a byte fold spreads well */
+static uint8 Gsv2k11KsvHashSlot(uint8 *Ksv)
+{
+    return (uint8)(Ksv[0] ^ (Ksv[1]<<1) ^ (Ksv[2]<<2) ^ (Ksv[3]<<3) ^ Ksv[4] ^ (Ksv[4]>>4));
+}
+
+/* list position of a Ksv, or Gsv2k11KsvListMax if not listed */
+static uint8 Gsv2k11KsvFind(pin AvPort *port, uint8 *Ksv)
+{
+    uint8 Slot = Gsv2k11KsvHashSlot(Ksv);
+    uint8 Entry = 0;
+    uint16 i = 0;
+
+    for(i=0;i<Gsv2k11KsvHashSize;i++)
+    {
+        Entry = RxKsvHash(port)[Slot];
+        if(Entry == 0)
+            break;
+        if(AvMemcmp(Ksv, &RxKsvList(port)[(Entry-1)*5], 5) == 0)
+            return Entry-1;
+        Slot = Slot + 1;
+    }
+    return Gsv2k11KsvListMax;
+}
+
+/* index the Ksv at a list position, linear probing, at most half full */
+static void Gsv2k11KsvIndex(pin AvPort *port, uint8 Position)
+{
+    uint8 *Ksv = &RxKsvList(port)[Position*5];
+    uint8 Slot = 0;
+
+    if((Ksv[0] | Ksv[1] | Ksv[2] | Ksv[3] | Ksv[4]) == 0)
+        return;
+    Slot = Gsv2k11KsvHashSlot(Ksv);
+    while(RxKsvHash(port)[Slot] != 0)
+        Slot = Slot + 1;
+    RxKsvHash(port)[Slot] = Position + 1;
+}
+
+/* drop the index of a list position, the rest of its probe run moves up into the hole */
+static void Gsv2k11KsvUnindex(pin AvPort *port, uint8 Position)
+{
+    uint8 *Ksv = &RxKsvList(port)[Position*5];
+    uint8 Hole = 0;
+    uint8 Slot = 0;
+    uint8 Home = 0;
+    uint8 Entry = 0;
+
+    if((Ksv[0] | Ksv[1] | Ksv[2] | Ksv[3] | Ksv[4]) == 0)
+        return;
+    Hole = Gsv2k11KsvHashSlot(Ksv);
+    while(RxKsvHash(port)[Hole] != (Position + 1))
+    {
+        if(RxKsvHash(port)[Hole] == 0)
+            return;
+        Hole = Hole + 1;
+    }
+    RxKsvHash(port)[Hole] = 0;
+    for(Slot=Hole+1; RxKsvHash(port)[Slot]!=0; Slot++)
+    {
+        Entry = RxKsvHash(port)[Slot];
+        Home = Gsv2k11KsvHashSlot(&RxKsvList(port)[(Entry-1)*5]);
+        /* an entry whose home is not between the hole and its slot fills the hole */
+        if((uint8)(Slot - Home) >= (uint8)(Slot - Hole))
+        {
+            RxKsvHash(port)[Hole] = Entry;
+            RxKsvHash(port)[Slot] = 0;
+            Hole = Slot;
+        }
+    }
+}
+
+/* index the Ksvs of the host copy */
+static void Gsv2k11KsvReindex(pin AvPort *port)
+{
+    uint8 Position = 0;
+
+    AvMemset(RxKsvHash(port), 0, Gsv2k11KsvHashSize);
+    for(Position=0;Position<RxKsvCount(port);Position++)
+        Gsv2k11KsvIndex(port, Position);
+}
+
+/* write bytes of the host copy to the Rx Ksv Fifo, one transfer per map page */
+static void Gsv2k11KsvWrite(pin AvPort *port, uint16 BytePtrStart, uint16 Length)
+{
+    uint8 StartReg = 0x80;
+    uint16 Offset = 0;
+    uint16 Size = 0;
+
+    while(Length != 0)
+    {
+        Offset = BytePtrStart % Gsv2k11KsvPageSize;
+        Size = Gsv2k11KsvPageSize - Offset;
+        if(Size > Length)
+            Size = Length;
+        GSV2K11_RXRPT_set_HDCP_MAP_SEL(port, (uint8)(BytePtrStart/Gsv2k11KsvPageSize));
+        AvHalI2cWriteMultiField(GSV2K11_RXRPT_MAP_ADDR(port), StartReg+(uint8)Offset, Size,
+                                &RxKsvList(port)[BytePtrStart]);
+        BytePtrStart = BytePtrStart + Size;
+        Length = Length - Size;
+    }
+    GSV2K11_RXRPT_set_HDCP_MAP_SEL(port, 0);
+}
+
+/**
+ * @brief  check whether a Bksv is in the Rx Ksv list
+ * @return AvOk if listed within SinkTotal, AvNotAvailable if not
+ * @note   looked up in the host copy, no i2c access
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxCheckBksvExisted(pin AvPort *port, uint8 *Bksv))
+{
+    uint8 Position = Gsv2k11KsvFind(port, Bksv);
+
+    if(Position < port->content.hdcp->SinkTotal)
+        return AvOk;
+    return AvNotAvailable;
+}
+
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxAddBksv(pio AvPort *port, uint8 *Value, uint8 Position))
+{
+    AvRet ret = AvOk;
+
+    if(Position >= Gsv2k11KsvListMax)
+        return AvInvalidParameter;
+    AvUapiOutputDebugMessage("Add BKSV to Rx No.%d", Position);
+
+    if(Position < RxKsvCount(port))
+        Gsv2k11KsvUnindex(port, Position);
+    else
+    {
+        /* positions skipped over read back as empty */
+        AvMemset(&RxKsvList(port)[RxKsvCount(port)*5], 0, (Position-RxKsvCount(port))*5);
+        RxKsvCount(port) = Position + 1;
+    }
+    AvMemcpy(&RxKsvList(port)[Position*5], Value, 5);
+    Gsv2k11KsvIndex(port, Position);
+    Gsv2k11KsvWrite(port, Position*5, 5);
+
+    return ret;
+}
+
+/**
+ * @brief  replace the Rx Ksv list
+ * @return AvOk if success, AvInvalidParameter if the list does not fit
+ * @note   the Fifo is programmed page by page instead of Ksv by Ksv
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxSetKsvList(pio AvPort *port, uint8 *List, uint8 Count))
+{
+    AvRet ret = AvOk;
+
+    if(Count > Gsv2k11KsvListMax)
+        return AvInvalidParameter;
+    AvMemcpy(RxKsvList(port), List, Count*5);
+    RxKsvCount(port) = Count;
+    Gsv2k11KsvReindex(port);
+    Gsv2k11KsvWrite(port, 0, Count*5);
+
+    return ret;
+}
+
+#else
 uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxCheckBksvExisted(pin AvPort *port, uint8 *Bksv))
 {
     AvRet ret = AvNotAvailable;
@@ -2490,9 +2972,10 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxCheckBksvExisted(pin AvPort *port, uin
             AvHalI2cReadMultiField(GSV2K11_RXRPT_MAP_ADDR(port), StartReg+(uint8)(BytePtrStart&0x007F), 5, Value);
         /* Step 3. Compare the value */
         if(AvMemcmp(Bksv, Value, 5) == 0)
+        {
             ret = AvOk;
-        else
-            ret = AvNotAvailable;
+            break;
+        }
     }
 
     return ret;
@@ -2533,6 +3016,18 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxAddBksv(pio AvPort *port, uint8 *Value
     return ret;
 }
 
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxSetKsvList(pio AvPort *port, uint8 *List, uint8 Count))
+{
+    AvRet ret = AvOk;
+    uint8 Position = 0;
+
+    for(Position=0;(Position<Count) && (ret == AvOk);Position++)
+        ret = AvUapiRxAddBksv(port, &List[Position*5], Position);
+
+    return ret;
+}
+#endif
+
 uapi AvRet ImplementUapi(Gsv2k11, AvUapiTxGetBksvTotal(pio AvPort *port, uint8 *Value))
 {
     AvRet ret = AvOk;
@@ -2611,6 +3106,10 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxGetPacketContent(pio AvPort *port, Pac
         port->content.rx->Cks.AvCks = Content[3];
         //AvUapiOutputDebugMessage("Port %d: Av Info [4] = %x, [7] = %x", port->index, Content[4], Content[7]);
     }
+#if AvEnableEqPresets
+    else if((Pkt == AV_PKT_SPD_PACKET) && (ret == AvOk) && (port->type == HdmiRx))
+        Gsv2k11RxEqSourceUpdate(port, Content);
+#endif
     return ret;
 }
 
@@ -2844,6 +3343,161 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxClearHdcpInterrupt(pio AvPort *port, H
     return ret;
 }
 
+/**
+ * @brief  acknowledge the tx cec results and latch them for the cec readers
+ * @return none
+ */
+static void Gsv2k11CecIntLatch(pin AvPort *port)
+{
+    uint8 value = 0;
+    uint8 Fired = 0;
+
+    GSV2K11_INT_get_TX1_TX_CEC_READY_INT_ST(port, &value);
+    if(value == 1)
+        Fired = Fired | Gsv2k11LatchCecTxReady;
+    GSV2K11_INT_get_TX1_TX_ARBITRATION_LOST_INT_ST(port, &value);
+    if(value == 1)
+        Fired = Fired | Gsv2k11LatchCecArbLost;
+    GSV2K11_INT_get_TX1_TX_RETRY_TIMEOUT_INT_ST(port, &value);
+    if(value == 1)
+        Fired = Fired | Gsv2k11LatchCecTimeout;
+    if(Fired == 0)
+        return;
+    if(Fired & Gsv2k11LatchCecTxReady)
+        GSV2K11_INT_set_TX1_TX_CEC_READY_CLEAR(port,          1);
+    if(Fired & Gsv2k11LatchCecArbLost)
+        GSV2K11_INT_set_TX1_TX_ARBITRATION_LOST_CLEAR(port,   1);
+    if(Fired & Gsv2k11LatchCecTimeout)
+        GSV2K11_INT_set_TX1_TX_RETRY_TIMEOUT_CLEAR(port,      1);
+    IntLatch(port) = IntLatch(port) | Fired;
+}
+
+/**
+ * @brief  read pending interrupt sources and decode them into AV_BIT_INT_* events
+ * @return AvOk: success
+ * @note   RX1 INT_ST bits are left untouched, they are masked off by the caller
+ *         and consumed by the FSM functions when the port is updated. Sources
+ *         without MASKB are acknowledged here and latched for the FSM instead,
+ *         they would hold the interrupt pin asserted otherwise.
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiGetInterrupt(pin AvPort *port, pout uint32 *IntEvents))
+{
+    AvRet ret = AvOk;
+    uint8 value = 0;
+
+    *IntEvents = 0;
+    if(port->type == HdmiRx)
+    {
+        /* Lock */
+        GSV2K11_INT_get_RXA_TMDSPLL_LOCK_DET_INT_ST(port, &value);
+        if(value == 1)
+        {
+            GSV2K11_INT_set_RXA_TMDSPLL_LOCK_DET_CLEAR(port, 1);
+            IntLatch(port) = IntLatch(port) | Gsv2k11LatchPllLockDet;
+            *IntEvents = *IntEvents | AV_BIT_INT_RX_LOCK;
+        }
+        Gsv2k11IntptEvent(HS_LOCKED,           AV_BIT_INT_RX_LOCK);
+        Gsv2k11IntptEvent(VS_LOCKED,           AV_BIT_INT_RX_LOCK);
+        Gsv2k11IntptEvent(CLKCHANGEDETECTED,   AV_BIT_INT_RX_LOCK);
+        /* Video */
+        Gsv2k11IntptEvent(HDMI_MODE,           AV_BIT_INT_RX_VIDEO);
+        Gsv2k11IntptEvent(AVMUTE,              AV_BIT_INT_RX_VIDEO);
+        Gsv2k11IntptEvent(DEEP_COLOR_CHANGE,   AV_BIT_INT_RX_VIDEO);
+        Gsv2k11IntptEvent(PKTDET_AVI_IF,       AV_BIT_INT_RX_VIDEO);
+        Gsv2k11IntptEvent(PKTDET_VS_IF,        AV_BIT_INT_RX_VIDEO);
+        /* Audio */
+        Gsv2k11IntptEvent(PKTDET_AUD_IF,       AV_BIT_INT_RX_AUDIO);
+        Gsv2k11IntptEvent(CSDATA_VALID,        AV_BIT_INT_RX_AUDIO);
+        /* Hdcp */
+        Gsv2k11IntptEvent(AKSV_UPDATE,         AV_BIT_INT_RX_HDCP);
+        Gsv2k11IntptEvent(HDCP1P4_ENCRYPTED,   AV_BIT_INT_RX_HDCP);
+    }
+    else if((port->type == HdmiTx) && (port->index == 5))
+    {
+        GSV2K11_INT_get_TXB_HPD_INTR_INT_ST(port, &value);
+        if(value == 1)
+        {
+            GSV2K11_INT_set_TXB_HPD_INTR_CLEAR(port, 1);
+            IntLatch(port) = IntLatch(port) | Gsv2k11LatchTxHpd;
+            *IntEvents = *IntEvents | AV_BIT_INT_TX_HPD;
+        }
+        /* cec frame sent or given up */
+        Gsv2k11CecIntLatch(port);
+        if(IntLatch(port) & Gsv2k11LatchCecAll)
+            *IntEvents = *IntEvents | AV_BIT_INT_TX_CEC;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief  route interrupt sources of the given events to the interrupt pin
+ * @return AvOk: success
+ * @note   RXA_TMDSPLL_LOCK_DET, TXB_HPD_INTR and the TX1 cec results have no
+ *         MASKB field, they can not be gated. Enabling them acknowledges a
+ *         stale status so that the next change asserts the pin again.
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiEnableInterrupt(pin AvPort *port, uint32 IntEvents, uint8 Enable))
+{
+    AvRet ret = AvOk;
+    uint8 value = Enable ? 1 : 0;
+
+    if((port->type == HdmiTx) && (port->index == 5))
+    {
+        if((Enable == 1) && (IntEvents & AV_BIT_INT_TX_HPD))
+        {
+            GSV2K11_INT_get_TXB_HPD_INTR_INT_ST(port, &value);
+            if(value == 1)
+            {
+                GSV2K11_INT_set_TXB_HPD_INTR_CLEAR(port, 1);
+                IntLatch(port) = IntLatch(port) | Gsv2k11LatchTxHpd;
+            }
+        }
+        if((Enable == 1) && (IntEvents & AV_BIT_INT_TX_CEC))
+            Gsv2k11CecIntLatch(port);
+        return ret;
+    }
+    if(port->type != HdmiRx)
+        return ret;
+    if((Enable == 1) && (IntEvents & AV_BIT_INT_RX_LOCK))
+    {
+        GSV2K11_INT_get_RXA_TMDSPLL_LOCK_DET_INT_ST(port, &value);
+        if(value == 1)
+        {
+            GSV2K11_INT_set_RXA_TMDSPLL_LOCK_DET_CLEAR(port, 1);
+            IntLatch(port) = IntLatch(port) | Gsv2k11LatchPllLockDet;
+        }
+        value = 1;
+    }
+
+    if(IntEvents & AV_BIT_INT_RX_LOCK)
+    {
+        Gsv2k11IntptMask(HS_LOCKED,           value);
+        Gsv2k11IntptMask(VS_LOCKED,           value);
+        Gsv2k11IntptMask(CLKCHANGEDETECTED,   value);
+    }
+    if(IntEvents & AV_BIT_INT_RX_VIDEO)
+    {
+        Gsv2k11IntptMask(HDMI_MODE,           value);
+        Gsv2k11IntptMask(AVMUTE,              value);
+        Gsv2k11IntptMask(DEEP_COLOR_CHANGE,   value);
+        Gsv2k11IntptMask(PKTDET_AVI_IF,       value);
+        Gsv2k11IntptMask(PKTDET_VS_IF,        value);
+    }
+    if(IntEvents & AV_BIT_INT_RX_AUDIO)
+    {
+        Gsv2k11IntptMask(PKTDET_AUD_IF,       value);
+        Gsv2k11IntptMask(CSDATA_VALID,        value);
+    }
+    if(IntEvents & AV_BIT_INT_RX_HDCP)
+    {
+        Gsv2k11IntptMask(AKSV_UPDATE,         value);
+        Gsv2k11IntptMask(HDCP1P4_ENCRYPTED,   value);
+    }
+
+    return ret;
+}
+
 /**
  * @brief  Enable/Disable packets and info-frames
  * @return AvOk: success
@@ -3228,6 +3882,15 @@ void Gsv2k11GetRx5VStatus(pin AvPort *port)
     uint8 value = 0;
     GSV2K11_INT_get_RXA_CABLE_DETECT_RAW_ST(port, &value);
     port->content.rx->Input5V = value;
+#if AvEnableEqPresets
+    /* the next source is unknown until its spd is read */
+    if(value == 0)
+    {
+        RxSourceKey(port) = 0;
+        RxEqTrial(port) = 0;
+        RxEqLearnPending(port) = 0;
+    }
+#endif
 }
 
 void Gsv2k11ToggleTmdsOut(AvPort *port, uint8 Enable)
@@ -3911,6 +4574,11 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxGetVideoLock(pio AvPort *port))
         Gsv2k11RpllProtect(port);
     /* Step 2. Check whether tmds_pll_lock value has changed */
     GSV2K11_INT_get_RXA_TMDSPLL_LOCK_DET_INT_ST(port, &tmds_pll_lock_flag);
+    if(IntLatch(port) & Gsv2k11LatchPllLockDet)
+    {
+        IntLatch(port) = IntLatch(port) & (~Gsv2k11LatchPllLockDet);
+        tmds_pll_lock_flag = 1;
+    }
     if(tmds_pll_lock_flag)
     {
         GSV2K11_INT_set_RXA_TMDSPLL_LOCK_DET_CLEAR(port, 1);
@@ -4472,6 +5140,114 @@ AvRet ImplementUapi(Gsv2k11, AvUapiTxCecSetLogicalAddr(AvPort *port))
 
 
 
+/**
+ * @brief  power the cec engine up or down
+ * @return AvOk: success
+ * @note   used when the cec engine is driven from outside the cec fsm
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecEnable(pin AvPort *port, uint8 Enable))
+{
+    GSV2K11_TXCEC_set_CEC_POWER_MODE(port, Enable);
+    if(Enable == 1)
+        GSV2K11_TXCEC_set_CEC_RX_3BUFFERS_ENABLE(port, 1);
+    else
+        GSV2K11_TXCEC_set_CEC_LOGIC_ADDR_SELECTION(port, 0);
+    return AvOk;
+}
+
+/**
+ * @brief  set or clear one of the 3 logical addresses the cec engine acks
+ * @return AvOk: success, AvInvalidParameter for an invalid slot
+ * @note   LogAddr 0xF clears the slot
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecSetLogAddr(pin AvPort *port, uint8 Slot, uint8 LogAddr))
+{
+    uint8 Mask = 0;
+    uint8 SlotBit = 1<<Slot;
+
+    switch(Slot)
+    {
+        case 0:
+            GSV2K11_TXCEC_set_CEC_LOGIC_ADDR0(port, LogAddr & 0xF);
+            break;
+        case 1:
+            GSV2K11_TXCEC_set_CEC_LOGIC_ADDR1(port, LogAddr & 0xF);
+            break;
+        case 2:
+            GSV2K11_TXCEC_set_CEC_LOGIC_ADDR2(port, LogAddr & 0xF);
+            break;
+        default:
+            return AvInvalidParameter;
+    }
+    GSV2K11_TXCEC_get_CEC_LOGIC_ADDR_SELECTION(port, &Mask);
+    if(LogAddr == 0xF)
+        Mask = Mask & (~SlotBit);
+    else
+        Mask = Mask | SlotBit;
+    GSV2K11_TXCEC_set_CEC_LOGIC_ADDR_SELECTION(port, Mask);
+    return AvOk;
+}
+
+/**
+ * @brief  start sending a cec frame
+ * @return AvOk: success, AvInvalidParameter for an invalid frame
+ * @note   the result is reported by AvUapiCecGetTxStatus, Retry is 0 to 7
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecTransmit(pin AvPort *port, uint8 *Msg, uint8 Len, uint8 Retry))
+{
+    uint8 value = 0;
+
+    if((Len == 0) || (Len > 16))
+        return AvInvalidParameter;
+    GSV2K11_TXCEC_get_CEC_TX_ENABLE(port, &value);
+    if(value == 1)
+        GSV2K11_TXCEC_set_CEC_TX_ENABLE(port, 0);
+    /* clear the results of the previous frame */
+    if(port->index == 5)
+    {
+        GSV2K11_INT_set_TX1_TX_CEC_READY_CLEAR(port,          1);
+        GSV2K11_INT_set_TX1_TX_ARBITRATION_LOST_CLEAR(port,   1);
+        GSV2K11_INT_set_TX1_TX_RETRY_TIMEOUT_CLEAR(port,      1);
+        IntLatch(port) = IntLatch(port) & (~Gsv2k11LatchCecAll);
+    }
+    AvHalI2cWriteMultiField(GSV2K11_TXCEC_MAP_ADDR(port), 0x00, Len, Msg);
+    GSV2K11_TXCEC_set_CEC_TX_FRAME_LENGTH(port, Len);
+    GSV2K11_TXCEC_set_CEC_TX_RETRY(port, (Retry > 7) ? 7 : Retry);
+    GSV2K11_TXCEC_set_CEC_TX_ENABLE(port, 1);
+    return AvOk;
+}
+
+/**
+ * @brief  read and clear the result of the frame sent
+ * @return AvOk: success
+ * @note   Status is 0 while the frame is still being sent, else AV_BIT_CEC_TX_* bits
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecGetTxStatus(pin AvPort *port, pout uint8 *Status, pout uint8 *NackCount, pout uint8 *LowDriveCount))
+{
+    uint8 value = 0;
+
+    *Status = 0;
+    if(port->index != 5)
+        return AvOk;
+    /* results already acknowledged by AvUapiGetInterrupt are in the latch */
+    Gsv2k11CecIntLatch(port);
+    value = IntLatch(port);
+    if(value & Gsv2k11LatchCecTxReady)
+        *Status = *Status | AV_BIT_CEC_TX_READY;
+    if(value & Gsv2k11LatchCecArbLost)
+        *Status = *Status | AV_BIT_CEC_TX_ARB_LOST;
+    if(value & Gsv2k11LatchCecTimeout)
+        *Status = *Status | AV_BIT_CEC_TX_TIMEOUT;
+    if(*Status == 0)
+        return AvOk;
+
+    GSV2K11_TXCEC_get_CEC_TX_NACK_COUNTER(port, NackCount);
+    GSV2K11_TXCEC_get_TX_LOWDRIVE_COUNTER(port, LowDriveCount);
+    GSV2K11_TXCEC_set_CEC_TX_ENABLE(port, 0);
+    IntLatch(port) = IntLatch(port) & (~Gsv2k11LatchCecAll);
+    return AvOk;
+}
+
 /*============================================================================
  *
  * Entry:   CecInts = CEC interrupts
@@ -4481,10 +5257,14 @@ AvRet ImplementUapi(Gsv2k11, AvUapiTxCecSetLogicalAddr(AvPort *port))
  *
  *===========================================================================*/
 
-uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecRxGetStatus (AvPort* port))
+/**
+ * @brief  read the oldest received cec frame and release its buffer
+ * @return AvOk if a frame was read, AvNotAvailable if none is buffered
+ * @note   Msg must hold 17 bytes, Len is the frame length
+ */
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecReceive(pin AvPort *port, pout uint8 *Msg, pout uint8 *Len))
 {
     AvRet ret = AvNotAvailable;
-#if AvEnableCecFeature /* CEC Related */
     uint8 BufferOrder = 0;
     uint8 SelectOrder = 0;
     uint8 value0, value1, value2;
@@ -4497,12 +5277,7 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecRxGetStatus (AvPort* port))
     if((value0 == 0) &&
        (value1 == 0) &&
        (value2 == 0))
-    {
-        port->content.cec->RxGetFlag = 0;
         return ret;
-    }
-    else
-        port->content.cec->RxGetFlag = 1;
 
     /* 2. Find the Lowest Value */
     GSV2K11_TXCEC_get_CEC_RX_BUF0_TIMESTAMP(port, &BufferOrder);
@@ -4533,8 +5308,8 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecRxGetStatus (AvPort* port))
     {
         case CEC_RX_BUFFER1:
             AvHalI2cReadMultiField(GSV2K11_TXCEC_MAP_ADDR(port), 0x15, 17,
-                                   port->content.cec->RxContent);
-            GSV2K11_TXCEC_get_CEC_RX_BUF0_FRAME_LENGTH(port, &port->content.cec->RxLen);
+                                   Msg);
+            GSV2K11_TXCEC_get_CEC_RX_BUF0_FRAME_LENGTH(port, Len);
             /* CEC buffer1 flag need to do toggling */
             GSV2K11_TXCEC_set_CEC_RX_CLEAR_BUF0(port,1);
             GSV2K11_TXCEC_set_CEC_RX_CLEAR_BUF0(port,0);
@@ -4542,8 +5317,8 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecRxGetStatus (AvPort* port))
             break;
         case CEC_RX_BUFFER2:
             AvHalI2cReadMultiField(GSV2K11_TXCEC_MAP_ADDR(port), 0x27, 17,
-                                   port->content.cec->RxContent);
-            GSV2K11_TXCEC_get_CEC_RX_BUF1_FRAME_LENGTH(port, &port->content.cec->RxLen);
+                                   Msg);
+            GSV2K11_TXCEC_get_CEC_RX_BUF1_FRAME_LENGTH(port, Len);
             /* CEC buffer2 flag need to do toggling */
             GSV2K11_TXCEC_set_CEC_RX_CLEAR_BUF1(port,1);
             GSV2K11_TXCEC_set_CEC_RX_CLEAR_BUF1(port,0);
@@ -4551,8 +5326,8 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecRxGetStatus (AvPort* port))
             break;
         case CEC_RX_BUFFER3:
             AvHalI2cReadMultiField(GSV2K11_TXCEC_MAP_ADDR(port), 0x38, 17,
-                                   port->content.cec->RxContent);
-            GSV2K11_TXCEC_get_CEC_RX_BUF2_FRAME_LENGTH(port, &port->content.cec->RxLen);
+                                   Msg);
+            GSV2K11_TXCEC_get_CEC_RX_BUF2_FRAME_LENGTH(port, Len);
             /* CEC buffer3 flag need to do toggling */
             GSV2K11_TXCEC_set_CEC_RX_CLEAR_BUF2(port,1);
             GSV2K11_TXCEC_set_CEC_RX_CLEAR_BUF2(port,0);
@@ -4561,6 +5336,15 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecRxGetStatus (AvPort* port))
         default:
             break;
     }
+    return ret;
+}
+
+uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecRxGetStatus (AvPort* port))
+{
+    AvRet ret = AvNotAvailable;
+#if AvEnableCecFeature /* CEC Related */
+    ret = AvUapiCecReceive(port, port->content.cec->RxContent, &port->content.cec->RxLen);
+    port->content.cec->RxGetFlag = (ret == AvOk);
 #endif
     return ret;
 }
@@ -4586,6 +5370,7 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecSendMessage(pin AvPort *port))
             GSV2K11_INT_set_TX1_TX_CEC_READY_CLEAR(port,          1);
             GSV2K11_INT_set_TX1_TX_ARBITRATION_LOST_CLEAR(port,   1);
             GSV2K11_INT_set_TX1_TX_RETRY_TIMEOUT_CLEAR(port,      1);
+            IntLatch(port) = IntLatch(port) & (~Gsv2k11LatchCecAll);
         }
 
         /* CecTxState = CEC_TX_STATE_BUSY; */
@@ -4625,9 +5410,11 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiCecTxGetStatus(pin AvPort *port))
 #if AvEnableCecFeature /* CEC Related */
     if(port->index == 5)
     {
-        GSV2K11_INT_get_TX1_TX_CEC_READY_INT_ST(port,        &port->content.cec->TxReady);
-        GSV2K11_INT_get_TX1_TX_ARBITRATION_LOST_INT_ST(port, &port->content.cec->ArbLost);
-        GSV2K11_INT_get_TX1_TX_RETRY_TIMEOUT_INT_ST(port,    &port->content.cec->Timeout);
+        /* the results stay latched until the next frame is sent */
+        Gsv2k11CecIntLatch(port);
+        port->content.cec->TxReady = (IntLatch(port) & Gsv2k11LatchCecTxReady) ? 1 : 0;
+        port->content.cec->ArbLost = (IntLatch(port) & Gsv2k11LatchCecArbLost) ? 1 : 0;
+        port->content.cec->Timeout = (IntLatch(port) & Gsv2k11LatchCecTimeout) ? 1 : 0;
     }
 
     GSV2K11_TXCEC_get_TX_LOWDRIVE_COUNTER(port,          &port->content.cec->LowDriveCount);
@@ -4662,6 +5449,60 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxReadEdid(pio AvPort *port, uint8 *Valu
     return ret;
 }
 
+#if AvEdidRamShadow
+/**
+ * @brief  write a range of the selected Edid Ram page, skipping bytes it already holds
+ * @return AvOk if success
+ * @note   changed bytes are written in bursts, an unknown page is written in full
+ */
+static AvRet Gsv2k11RxEdidRamWrite(pio AvPort *port, uint8 Page, uint16 Offset, uint16 Count, uint8 *Value)
+{
+    AvRet ret = AvOk;
+    uint8 *Shadow = RxEdidRam(port)[Page];
+    uint16 End = Offset + Count;
+    uint16 Start = 0;
+    uint16 Last = 0;
+    uint16 i = 0;
+
+    if(End > 256)
+    {
+        RxEdidRamValid(port)[Page] = 0;
+        return AvHalI2cWriteMultiField(GSV2K11_HDMI_EDID_ADDR(port), Offset, Count, Value);
+    }
+    if(RxEdidRamValid(port)[Page] == 0)
+    {
+        ret = AvHalI2cWriteMultiField(GSV2K11_HDMI_EDID_ADDR(port), Offset, Count, Value);
+        AvMemcpy(Shadow+Offset, Value, Count);
+        /* only a full page write makes the shadow trustworthy */
+        if((ret == AvOk) && (Offset == 0) && (Count == 256))
+            RxEdidRamValid(port)[Page] = 1;
+        return ret;
+    }
+
+    for(i=Offset; i<End; i++)
+    {
+        if(Shadow[i] == Value[i-Offset])
+            continue;
+        Start = i;
+        Last = i;
+        for(i=i+1; (i<End) && ((i-Last) <= Gsv2k11EdidBurstGap); i++)
+        {
+            if(Shadow[i] != Value[i-Offset])
+                Last = i;
+        }
+        if(AvHalI2cWriteMultiField(GSV2K11_HDMI_EDID_ADDR(port), Start, Last-Start+1, Value+(Start-Offset)) != AvOk)
+        {
+            RxEdidRamValid(port)[Page] = 0;
+            ret = AvError;
+        }
+        i = Last;
+    }
+    AvMemcpy(Shadow+Offset, Value, Count);
+
+    return ret;
+}
+#endif
+
 /* Rx Write Edid */
 uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxWriteEdid(pio AvPort *port, uint8 *Value, uint16 Count))
 {
@@ -4672,11 +5513,19 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxWriteEdid(pio AvPort *port, uint8 *Val
     /* Edid1 selection */
     GSV2K11_RXRPT_set_RX_EDID_RAM_SEL(port, 0);
     GSV2K11_RXRPT_set_RX_EDID_RAM_PAGE_SEL(port, 0);
+#if AvEdidRamShadow
+    ret = Gsv2k11RxEdidRamWrite(port, 0, 0, 256, Value);
+#else
     AvHalI2cWriteMultiField(GSV2K11_HDMI_EDID_ADDR(port), 0, 256, Value);
+#endif
     if(Count > 256)
     {
         GSV2K11_RXRPT_set_RX_EDID_RAM_PAGE_SEL(port, 1);
+#if AvEdidRamShadow
+        ret = Gsv2k11RxEdidRamWrite(port, 1, 0, 256, (Value+256));
+#else
         AvHalI2cWriteMultiField(GSV2K11_HDMI_EDID_ADDR(port), 0, 256, (Value+256));
+#endif
     }
 
     return ret;
@@ -4697,13 +5546,20 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxSetSpa(pio AvPort *port, uint8 SpaLoca
     /* 1. Set SPA Location */
     /* using Edid1 */
     GSV2K11_RXRPT_set_RX_EDID1_SPA_LOC_LSB(port, SpaLocation);
+#if AvEdidRamShadow
+    RxEdidSpaLoc(port) = SpaLocation;
+#endif
     RamSel = 0;
     if(SpaLocation < 128)
     {
         GSV2K11_RXRPT_set_RX_EDID_RAM_SEL(port, RamSel);
         GSV2K11_RXRPT_set_RX_EDID_RAM_PAGE_SEL(port, 0);
         Spa = (SpaValue[0]<<8)+SpaValue[1];
+#if AvEdidRamShadow
+        Gsv2k11RxEdidRamWrite(port, 0, SpaLocation, 2, SpaValue);
+#else
         AvHalI2cWriteMultiField(GSV2K11_HDMI_EDID_ADDR(port), SpaLocation, 2, SpaValue);
+#endif
         return ret;
     }
     /* 2. Generate all Rx Spa values */
@@ -4732,12 +5588,51 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiRxSetSpa(pio AvPort *port, uint8 SpaLoca
     Spa = Spa + 1; /* e.g. XX10 */
     SpaValue[0] = (Spa<<SpaShift)>>8;
     SpaValue[1] = (Spa<<SpaShift)&0xff;
+#if AvEdidRamShadow
+    Gsv2k11RxEdidRamWrite(port, 0, SpaLocation, 2, SpaValue);
+#else
     AvHalI2cWriteMultiField(GSV2K11_HDMI_EDID_ADDR(port), SpaLocation, 2, SpaValue);
+#endif
 
 #endif
     return ret;
 }
 
+#if (AvEnableSinkEdidCache && (AvEdidStoredInRam == 0))
+/**
+ * @brief  check whether the sink edid in the tx edid map is the copy kept
+ * @return 1 if the ids, extension count and checksums all match, 0 if not
+ * @note   a few bytes over i2c instead of the full edid
+ */
+static uint8 Gsv2k11TxSinkEdidSame(pin AvPort *port)
+{
+    uint8 *Edid = TxBSinkEdid(port);
+    uint8 Value[Gsv2k11SinkEdidIdSize];
+    uint8 i = 0;
+
+    if(TxBSinkEdidValid(port) == 0)
+        return 0;
+    AvHalI2cReadMultiField(GSV2K11_TXEDID_MAP_ADDR(port), 0, Gsv2k11SinkEdidIdSize, Value);
+    for(i=0;i<Gsv2k11SinkEdidIdSize;i++)
+    {
+        if(Value[i] != Edid[i])
+            return 0;
+    }
+    /* extension count and block 0 checksum */
+    AvHalI2cReadMultiField(GSV2K11_TXEDID_MAP_ADDR(port), 0x7E, 2, Value);
+    if((Value[0] != Edid[0x7E]) || (Value[1] != Edid[0x7F]))
+        return 0;
+    /* block 1 checksum */
+    if(Value[0] != 0)
+    {
+        AvHalI2cReadField8(GSV2K11_TXEDID_MAP_ADDR(port), 0xFF, 0xFF, 0, &Value[1]);
+        if(Value[1] != Edid[0xFF])
+            return 0;
+    }
+    return 1;
+}
+#endif
+
 /* Tx Read Edid */
 uapi AvRet ImplementUapi(Gsv2k11, AvUapiTxReadEdid(pio AvPort *port, uint8 *Value, uint16 Count))
 {
@@ -4747,6 +5642,7 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiTxReadEdid(pio AvPort *port, uint8 *Valu
     uint8 CheckSum = 0;
     uint8 FsmState = 0;
     uint8 value = 0;
+    uint32 NowMs = 0;
 
 #if AvEdidStoredInRam
     /* Copy RAM into Edid Readback */
@@ -4762,28 +5658,33 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiTxReadEdid(pio AvPort *port, uint8 *Valu
     }
 #endif
 
-    /* protect EDID reread from Tx Port Reset */
-    while((ReadSuccess == 0) && (i < 3000))
+    /* protect EDID reread from Tx Port Reset, not ready is retried next tick up to AvEdidReadyTimeout */
+    AvHalGetMilliSecond(&NowMs);
+    if(port->content.tx->EdidWaiting == 0)
+        port->content.tx->EdidWaitStart = NowMs;
+    GSV2K11_TXPHY_get_TX_EDID_READY_RB(port, &ReadSuccess);
+    if(ReadSuccess != 1)
     {
-        GSV2K11_TXPHY_get_TX_EDID_READY_RB(port, &ReadSuccess);
-        if(ReadSuccess == 0)
+        GSV2K11_TXPHY_get_TX_HDCP1P4_STATE_RB(port,   &FsmState);
+        if(FsmState == 1) /* DDC Reading EDID */
+            value = Gsv2k11TxDDCError(port);
+        if(value == 1)
+            AvUapiOutputDebugMessage("Port%d: ReRead Edid Failure",port->index);
+        else if((NowMs - port->content.tx->EdidWaitStart) >= AvEdidReadyTimeout)
         {
-            GSV2K11_TXPHY_get_TX_HDCP1P4_STATE_RB(port,   &FsmState);
-            if(FsmState == 1) /* DDC Reading EDID */
-            {
-                value = Gsv2k11TxDDCError(port);
-                if(value == 1)
-                {
-                    AvUapiOutputDebugMessage("Port%d: ReRead Edid Failure",port->index);
-                    break;
-                }
-                else
-                    i = i + 1;
-            }
-            else
-                i = i + 1;
+            AvUapiOutputDebugMessage("Port%d: Edid Ready Timeout",port->index);
+            port->content.tx->EdidWaitTimeouts++;
+        }
+        else
+        {
+            port->content.tx->EdidWaiting = 1;
+            return AvNotAvailable;
         }
     }
+    port->content.tx->EdidWaiting = 0;
+    port->content.tx->EdidWaitMs = (uint16)(NowMs - port->content.tx->EdidWaitStart);
+    if(port->content.tx->EdidWaitMs > port->content.tx->EdidWaitMaxMs)
+        port->content.tx->EdidWaitMaxMs = port->content.tx->EdidWaitMs;
     /* Return if Edid read Failure or Illegal Edid */
     if(ReadSuccess == 1)
     {
@@ -4809,6 +5710,18 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiTxReadEdid(pio AvPort *port, uint8 *Valu
         #endif
         }
         AvUapiOutputDebugMessage("Port%d: Store Edid %d",port->index, value);
+#elif AvEnableSinkEdidCache
+        /* same sink after a hpd toggle, skip the full edid read */
+        if(Gsv2k11TxSinkEdidSame(port) == 1)
+        {
+            AvMemcpy(Value, TxBSinkEdid(port), Count);
+            port->content.tx->EdidCacheHits++;
+        }
+        else
+        {
+            TxBSinkEdidValid(port) = 0;
+            AvHalI2cReadMultiField(GSV2K11_TXEDID_MAP_ADDR(port), 0, Count, Value);
+        }
 #else
         AvHalI2cReadMultiField(GSV2K11_TXEDID_MAP_ADDR(port), 0, Count, Value);
 #endif
@@ -4845,6 +5758,15 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiTxReadEdid(pio AvPort *port, uint8 *Valu
 #endif
         return AvError;
     }
+#if (AvEnableSinkEdidCache && (AvEdidStoredInRam == 0))
+    /* keep the checksum verified edid for the next read */
+    if((TxBSinkEdidValid(port) == 0) && (Count <= AvEdidMaxSize))
+    {
+        AvMemcpy(TxBSinkEdid(port), Value, Count);
+        AvMemset(TxBSinkEdid(port)+Count, 0, AvEdidMaxSize-Count);
+        TxBSinkEdidValid(port) = 1;
+    }
+#endif
 
     if(port->content.tx->EdidReadSuccess != AV_EDID_UPDATED)
     {
@@ -5162,6 +6084,77 @@ void Gsv2k11ToggleDpllFreq(pin AvPort *port, uint8 index, uint8 Integer, uint8 *
     AvHalI2cWriteField8(GSV2K11_AG_MAP_ADDR(port),Offset+4,0xFF,0,DefaultValue);
 }
 
+#if AvEnableEqPresets
+/* lane frequency band, following the fast eq parameter plan */
+static uint8 Gsv2k11RxEqBand(pin AvPort *port)
+{
+    uint16 LaneFreq = port->content.video->info.LaneFreq;
+
+    if(LaneFreq < 60)
+        return 0;
+    else if(LaneFreq < 170)
+        return 1;
+    else if(LaneFreq < 250)
+        return 2;
+    else if(LaneFreq < 470)
+        return 3;
+    return 4;
+}
+
+static Gsv2k11EqPreset *Gsv2k11RxEqPresetFind(pin AvPort *port)
+{
+    uint8 Band = Gsv2k11RxEqBand(port);
+    uint8 i = 0;
+
+    if(RxSourceKey(port) == 0)
+        return NULL;
+    for(i=0;i<AvEqPresetEntries;i++)
+    {
+        if((RxEqPreset(port)[i].Valid == 1) &&
+           (RxEqPreset(port)[i].Band == Band) &&
+           (RxEqPreset(port)[i].SourceKey == RxSourceKey(port)))
+            return &RxEqPreset(port)[i];
+    }
+    return NULL;
+}
+
+/* remember the plan of the round that found the eye */
+static void Gsv2k11RxEqPresetLearn(pin AvPort *port)
+{
+    Gsv2k11EqPreset *Preset = Gsv2k11RxEqPresetFind(port);
+
+    if(Preset == NULL)
+    {
+        Preset = &RxEqPreset(port)[RxEqPresetNext(port)];
+        RxEqPresetNext(port) = (RxEqPresetNext(port) + 1) % AvEqPresetEntries;
+        Preset->SourceKey = RxSourceKey(port);
+        Preset->Band = Gsv2k11RxEqBand(port);
+        Preset->Valid = 1;
+    }
+    if((RxEqTrial(port) == 0) || (Preset->Plan != RxEqPlan(port)))
+        AvUapiOutputDebugMessage("Port Rx %d: Learn EQ Plan %d", port->index, RxEqPlan(port));
+    Preset->Plan = RxEqPlan(port);
+    RxEqTrial(port) = 0;
+    RxEqLearnPending(port) = 0;
+}
+
+/* fingerprint the vendor and product names of the spd infoframe,
+   a plan found before the first spd of the source is learned now */
+void Gsv2k11RxEqSourceUpdate(pin AvPort *port, uint8 *Content)
+{
+    uint32 Key = 0;
+    uint8 i = 0;
+
+    for(i=4;i<28;i++)
+        Key = (Key * 31) + Content[i];
+    /* 0 marks an unknown source */
+    if(Key == 0)
+        Key = 1;
+    RxSourceKey(port) = Key;
+    if(RxEqLearnPending(port) == 1)
+        Gsv2k11RxEqPresetLearn(port);
+}
+#endif
 
 void Gsv2k11RxManualEQUpdate(AvPort *port, uint8 DefaultEQEnable)
 {
@@ -5177,6 +6170,10 @@ void Gsv2k11RxManualEQUpdate(AvPort *port, uint8 DefaultEQEnable)
     uint16 BestEyeScore[3];
     uint8  EnhancedEqMode = 0;
     uint8  EnhancedFirstRound = 0;
+    uint8  PresetTrial = 0;
+#if AvEnableEqPresets
+    Gsv2k11EqPreset *Preset = NULL;
+#endif
     /* Step 1. Protocol Check Start */
     if(DefaultEQEnable)
     {
@@ -5297,6 +6294,12 @@ void Gsv2k11RxManualEQUpdate(AvPort *port, uint8 DefaultEQEnable)
         /* Step 2.2.2.1 Reset Rx Core Digital Logic for power cycle stability */
         if(port->content.rx->EQDelayExpire == 1)
         {
+#if AvEnableEqPresets
+            if(RxSourceKey(port) != 0)
+                Gsv2k11RxEqPresetLearn(port);
+            else
+                RxEqLearnPending(port) = 1;
+#endif
             GSV2K11_RXDIG_set_DCFIFO_RECENTER(port, 1);
             GSV2K11_RXAUD_set_RX_AUD_FIFO_RST(port, 1);
             GSV2K11_RXAUD_set_RX_AUD_FIFO_RST(port, 0);
@@ -5323,6 +6326,37 @@ void Gsv2k11RxManualEQUpdate(AvPort *port, uint8 DefaultEQEnable)
     /* Step 2.3 loop to change EQ setting */
     if(port->content.rx->EQDelayExpire == 0)
     {
+#if AvEnableEqPresets
+        /* Step 2.3.1.0 Start a new search from the plan learned for this source and band,
+           the next eye check validates it, a failing preset is dropped for the full search */
+        RxEqLearnPending(port) = 0;
+        if(DefaultEQEnable == 1)
+        {
+            Preset = Gsv2k11RxEqPresetFind(port);
+            if((Preset != NULL) && (Preset->Plan != Gsv2k11EqPlanFast))
+            {
+                EnhancedEqMode = 1;
+                EnhancedFirstRound = (Preset->Plan == Gsv2k11EqPlanEnhancedFirst);
+                PresetTrial = 1;
+                AvUapiOutputDebugMessage("Port Rx %d: Try Learned EQ Plan %d", port->index, Preset->Plan);
+            }
+            RxEqTrial(port) = (Preset != NULL);
+        }
+        else if(RxEqTrial(port) == 1)
+        {
+            Preset = Gsv2k11RxEqPresetFind(port);
+            if(Preset != NULL)
+                Preset->Valid = 0;
+            RxEqTrial(port) = 0;
+            AvUapiOutputDebugMessage("Port Rx %d: Learned EQ Plan Failed", port->index);
+        }
+        if(EnhancedEqMode == 0)
+            RxEqPlan(port) = Gsv2k11EqPlanFast;
+        else if(EnhancedFirstRound == 1)
+            RxEqPlan(port) = Gsv2k11EqPlanEnhancedFirst;
+        else
+            RxEqPlan(port) = Gsv2k11EqPlanEnhanced;
+#endif
         /* Step 2.3.1.1 Decide EQ Parameter Plan */
         if(EnhancedEqMode == 1)
         {
@@ -5369,7 +6403,7 @@ void Gsv2k11RxManualEQUpdate(AvPort *port, uint8 DefaultEQEnable)
         }
         /* Step 2.3.1.2 Decide EQ Manual Setting */
         if((port->core.HdmiCore != -1) &&
-           (EnhancedEqMode == 1) && (EnhancedFirstRound == 0))
+           (EnhancedEqMode == 1) && (EnhancedFirstRound == 0) && (PresetTrial == 0))
         {
             AvHalI2cReadMultiField(PhyPageAddr, 0x0C, 4, RbEQParam);
             if((RbEQParam[0] == EQParam[0]) &&
@@ -5411,7 +6445,7 @@ void Gsv2k11RxManualEQUpdate(AvPort *port, uint8 DefaultEQEnable)
         */
         /* Automatic EQ Register Setting Recovery */
         if((port->core.HdmiCore != -1) &&
-           ((EnhancedEqMode == 0) || (EnhancedFirstRound == 1)))
+           ((EnhancedEqMode == 0) || (EnhancedFirstRound == 1) || (PresetTrial == 1)))
         {
             AvHalI2cWriteField8(GSV2K11_RXDIG_MAP_ADDR(port),0xD9,0xFF,0,0x00);
         }
@@ -5540,6 +6574,7 @@ uapi AvRet ImplementUapi(Gsv2k11, AvUapiCheckLogicAudioRx(pin AvPort *port))
                             break;
                     }
                     AvUapiTxSetPacketContent(CurrentPort, AV_PKT_AUDIO_INFO_FRAME, PktContent,1);
+                    KfunTxClearPacketSign(CurrentPort);
                     /* 2.2.3 Set AV_PKT_AUDIO_CHANNEL_STATUS */
                     if((CurrentPort->content.audio->AudCoding == AV_AUD_FORMAT_LINEAR_PCM) || (CurrentPort->content.audio->AudCoding == 0x00))
                         CurrentPort->content.audio->Consumer = CurrentPort->content.audio->Consumer & 0x01;
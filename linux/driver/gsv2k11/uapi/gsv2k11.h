@@ -3,12 +3,19 @@
 
 #include "../av_config.h"
 
-#define Gsv2k11ResourceSize  (540+(AvEnableDetailTiming*144)+(AvEnableInternalVideoGen*40)+(AvEnableInternalAudioGen*24)+(AvEnableInternalClockGen*24)+(AvEnableCecFeature*72))
+#define Gsv2k11ResourceSize  (548+(AvEnableDetailTiming*144)+(AvEnableInternalVideoGen*40)+(AvEnableInternalAudioGen*24)+(AvEnableInternalClockGen*24)+(AvEnableCecFeature*72)+16+(AvEdidStoredInRam*AvEdidMaxSize)+(AvEdidRamShadow*520)+(AvEnableSinkEdidCache*(AvEdidMaxSize+4))+(AvEnableKsvIndex*896)+(AvEnableEqPresets*(AvEqPresetEntries*8+12)))
 
 #include "gsv2k11_device.h"
 
 /* supported uapi */
 #define Gsv2k11_AvUapiInitDevice
+#define Gsv2k11_AvUapiResumeDevice
+#define Gsv2k11_AvUapiRestoreDevice
+#define Gsv2k11_AvUapiRestorePort
+#define Gsv2k11_AvUapiReplayDevice
+#define Gsv2k11_AvUapiRegisterVolatile
+#define Gsv2k11_AvUapiRegisterPrecious
+#define Gsv2k11_AvUapiSnapshotPort
 #define Gsv2k11_AvUapiEnablePort
 #define Gsv2k11_AvUapiResetPort
 #define Gsv2k11_AvUapiRxPortInit
@@ -58,6 +65,7 @@
 #define Gsv2k11_AvUapiTxSetAviInfoFrame
 #define Gsv2k11_AvUapiTxReadBksv
 #define Gsv2k11_AvUapiRxAddBksv
+#define Gsv2k11_AvUapiRxSetKsvList
 #define Gsv2k11_AvUapiTxGetBksvTotal
 #define Gsv2k11_AvUapiTxSetBlackMute
 #define Gsv2k11_AvUapiTxEncryptSink
@@ -81,6 +89,11 @@
 #define Gsv2k11_AvUapiCecTxGetStatus
 #define Gsv2k11_AvUapiTxCecSetPhysicalAddr
 #define Gsv2k11_AvUapiTxCecSetLogicalAddr
+#define Gsv2k11_AvUapiCecEnable
+#define Gsv2k11_AvUapiCecSetLogAddr
+#define Gsv2k11_AvUapiCecTransmit
+#define Gsv2k11_AvUapiCecGetTxStatus
+#define Gsv2k11_AvUapiCecReceive
 #define Gsv2k11_AvUapiRxReadEdid
 #define Gsv2k11_AvUapiRxWriteEdid
 #define Gsv2k11_AvUapiRxSetSpa
@@ -98,6 +111,8 @@
 #define Gsv2k11_AvUapiCheckVideoGen
 #define Gsv2k11_AvUapiCheckAudioGen
 #define Gsv2k11_AvUapiCheckClockGen
+#define Gsv2k11_AvUapiGetInterrupt
+#define Gsv2k11_AvUapiEnableInterrupt
 
 
 #ifdef Gsv2k11_AvUapiTxSetAudioPackets
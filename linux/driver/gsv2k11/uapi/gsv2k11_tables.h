@@ -498,6 +498,84 @@ static const uint8 Gsv2k11InitTable[] = {
     0xFF,0xFF,0xFF
 };
 
+/* Volatile registers of the bsp regmap, per map: page, number of volatile registers,
+   volatile registers. These are the INT_ST, RAW_ST, RB_, detect, lock, self clearing
+   and trigger fields of GSV2K11_*_map_fct.h. Maps not listed (int, infoframe, edid,
+   scdc, hdcp2.2, cec and rx lane) are volatile as a whole. The regmap never writes
+   them back, the init table entries among them are replayed in init order by
+   AvUapiReplayDevice. */
+static const uint8 Gsv2k11VolatileTable[] = {
+    /* prim map */
+    0x00,2,
+        0xF5,0xFF,
+    /* sec map */
+    0x01,0,
+    /* pll map */
+    0x02,25,
+        0x2F,0x33,0x34,0x35,0x36,0x37,0x38,0x39,0x3A,0x86,0x8C,0x8D,
+        0x8E,0x90,0x91,0x92,0x93,0x94,0x95,0x96,0x97,0x98,0x9B,0x9C,
+        0xEC,
+    /* apll map */
+    0x05,0,
+    /* ppll map */
+    0x06,12,
+        0x86,0x8C,0x90,0x91,0x92,0x93,0x94,0x95,0x96,0x97,0x98,0x9B,
+    /* vsp map */
+    0x12,0,
+    /* par map */
+    0x14,1,
+        0x17,
+    /* ag map */
+    0x15,0,
+    /* rxdig map */
+    0x20,27,
+        0x00,0x03,0x09,0x0A,0x0B,0x0C,0x0D,0x0E,0x0F,0x22,0x26,0x27,
+        0x28,0x29,0x2A,0x2B,0x2C,0x2D,0x2E,0x2F,0x32,0x33,0x36,0x37,
+        0x3A,0x3B,0x7A,
+    /* rxaud map */
+    0x22,9,
+        0x04,0x17,0x18,0x19,0x48,0x5A,0x5B,0x65,0x81,
+    /* txdig map */
+    0x40,4,
+        0x04,0x4F,0x52,0xA6,
+    /* txpkt map */
+    0x42,2,
+        0xFB,0xFC,
+    /* txphy map */
+    0x70,23,
+        0x03,0x07,0x08,0x11,0x1C,0x1D,0x22,0x97,0xAA,0xAB,0xAC,0xBF,
+        0xC0,0xC1,0xC2,0xC3,0xC5,0xC7,0xC8,0xC9,0xCD,0xF1,0xF4,
+    0xFF
+};
+
+/* Maps whose reads pop a fifo or walk a packet or edid ram: rx edid, rx hdcp2.2,
+   rx infoframe, cec, tx edid and tx hdcp2.2. Only the driver itself reads them. */
+static const uint8 Gsv2k11PreciousTable[] = {
+    0x10,0x21,0x24,0x25,0x41,0x71,0x72,
+    0xFF
+};
+
+#if AvEnableI2cSnapshot
+/* Status snapshot, per port type: page, first register, number of registers.
+   Each block is read in one burst at the start of a port update and serves the
+   RB_, RAW_ST and INT_ST fields inside it for the rest of that update. Tx status
+   (txphy edid ready, ddc done) is polled in loops and is never snapshotted.
+   The blocks are read in one transfer, so they are volatile to the bsp regmap. */
+static const uint8 Gsv2k11RxSnapshotTable[] = {
+    /* int map: cable detect, tmds pll lock, packet and hdcp raw/int status */
+    0x03,0x10,0x30,
+    /* int map: new packet latches, read by both video and audio packet status */
+    0x03,0x50,0x1C,
+    /* rxdig map: hdmi mode, pixel repetition, deep color, timing readback */
+    0x20,0x00,0x3C,
+    /* pll map: rx vco frequency and serial divider */
+    0x02,0x2F,0x0C,
+    /* rxaud map: audio pll lock, packet detect */
+    0x22,0x04,0x16,
+    0xFF
+};
+#endif
+
 static const uint8 Gsv2k11EqTable[] = {
     0x58,0x01,
 
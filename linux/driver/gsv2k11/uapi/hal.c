@@ -7,6 +7,163 @@
 #include "hal.h"
 #include "uapi.h"
 
+#if AvEnableI2cSnapshot
+/* status registers read in one burst, valid until the page is written or dropped */
+typedef struct
+{
+    uint32 devAddress;   /* device and page address, 0 if the slot is free */
+    uint8  Reg;
+    uint8  Count;
+    uint8  Value[AvI2cSnapshotSize];
+} AvHalSnapshot;
+
+/* snapshots of one device, selected by the bus field of device address */
+typedef struct
+{
+    AvHalSnapshot  Snap[AvI2cSnapshotBlocks];
+} AvHalDevCache;
+
+static AvHalDevCache HalDevCache[AvMaxDeviceNumber];
+
+/**
+ * @brief  find the snapshots of a device
+ * @param  devAddress = any address of the device
+ * @return device state, NULL if the device index is out of range
+ */
+static AvHalDevCache *AvHalCacheDevice(pin uint32 devAddress)
+{
+    uint32 index = AvGetI2cBusAddress(devAddress);
+    if(index >= AvMaxDeviceNumber)
+        return NULL;
+    return &HalDevCache[index];
+}
+
+/**
+ * @brief  read a block of status registers in one burst
+ * @param  devAddress = device and page address
+ * @param  reg = first register of the block
+ * @param  count = number of registers, up to AvI2cSnapshotSize
+ * @return AvOk if success, AvError if no slot is left or the read failed
+ * @note   reads inside the block, volatile or not, are served from it until
+ * @note   the page is written or AvHalI2cSnapshotDrop is called, so blocks
+ * @note   must not cover registers which are polled in a loop
+ */
+AvRet AvHalI2cSnapshot(pin uint32 devAddress, pin uint8 reg, pin uint8 count)
+{
+    AvRet ret = AvOk;
+    AvHalDevCache *dev = AvHalCacheDevice(devAddress);
+    AvHalSnapshot *snap = NULL;
+    uint8 i = 0;
+
+    if((dev == NULL) || (count > AvI2cSnapshotSize) || ((reg + count) > 256))
+        return AvError;
+    for(i=0; i<AvI2cSnapshotBlocks; i++)
+    {
+        if((dev->Snap[i].devAddress == devAddress) && (dev->Snap[i].Reg == reg))
+        {
+            snap = &dev->Snap[i];
+            break;
+        }
+        if((snap == NULL) && (dev->Snap[i].devAddress == 0))
+            snap = &dev->Snap[i];
+    }
+    if(snap == NULL)
+        return AvError;
+
+    ret = AvI2cRead(devAddress, (0x080000 | reg), snap->Value, count);
+    if(ret == AvOk)
+    {
+        snap->devAddress = devAddress;
+        snap->Reg = reg;
+        snap->Count = count;
+    }
+    else
+        snap->devAddress = 0;
+    return ret;
+}
+
+/**
+ * @brief  drop every status snapshot of a device
+ * @param  devAddress = any address of the device, only the bus index is compared
+ * @return AvOk
+ */
+AvRet AvHalI2cSnapshotDrop(pin uint32 devAddress)
+{
+    AvHalDevCache *dev = AvHalCacheDevice(devAddress);
+    uint8 i = 0;
+    if(dev == NULL)
+        return AvOk;
+    for(i=0; i<AvI2cSnapshotBlocks; i++)
+        dev->Snap[i].devAddress = 0;
+    return AvOk;
+}
+
+/**
+ * @brief  serve a read from a status snapshot
+ * @return AvOk if every register is inside one snapshot, else AvError
+ */
+static AvRet AvHalSnapshotRead(pin uint32 devAddress, pin uint8 reg, pout uint8 *avdata, pin uint16 count)
+{
+    AvHalDevCache *dev = AvHalCacheDevice(devAddress);
+    AvHalSnapshot *snap = NULL;
+    uint8 i = 0;
+
+    if(dev == NULL)
+        return AvError;
+    for(i=0; i<AvI2cSnapshotBlocks; i++)
+    {
+        snap = &dev->Snap[i];
+        if((snap->devAddress == devAddress) && (reg >= snap->Reg) &&
+           ((reg + count) <= (snap->Reg + snap->Count)))
+        {
+            AvMemcpy(avdata, &snap->Value[reg - snap->Reg], count);
+            return AvOk;
+        }
+    }
+    return AvError;
+}
+
+/**
+ * @brief  drop the snapshots of a page which is written
+ * @note   a write may clear or retrigger any status of its page
+ */
+static void AvHalSnapshotClip(pin uint32 devAddress)
+{
+    AvHalDevCache *dev = AvHalCacheDevice(devAddress);
+    uint8 i = 0;
+    if(dev == NULL)
+        return;
+    for(i=0; i<AvI2cSnapshotBlocks; i++)
+    {
+        if(dev->Snap[i].devAddress == devAddress)
+            dev->Snap[i].devAddress = 0;
+    }
+}
+/**
+ * @brief  read registers, served from a status snapshot if one holds them
+ * @return AvOk if success, else AvError
+ */
+static AvRet AvHalCacheRead(pin uint32 devAddress, pin uint32 regAddress, pout uint8 *avdata, pin uint16 count)
+{
+    if(AvHalSnapshotRead(devAddress, AvGetRegAddress(regAddress), avdata, count) == AvOk)
+        return AvOk;
+    return AvI2cRead(devAddress, regAddress, avdata, count);
+}
+
+/**
+ * @brief  write registers to the bus
+ * @return AvOk if success, else AvError
+ */
+static AvRet AvHalCacheWrite(pin uint32 devAddress, pin uint32 regAddress, pin uint8 *avdata, pin uint16 count)
+{
+    AvHalSnapshotClip(devAddress);
+    return AvI2cWrite(devAddress, regAddress, avdata, count);
+}
+#else
+#define AvHalCacheRead   AvI2cRead
+#define AvHalCacheWrite  AvI2cWrite
+#endif
+
 /**
  * @brief  abstract i2c read function
  * @param  devAddress = device address
@@ -35,7 +192,7 @@ AvRet AvHalI2cRead(pin uint32 devAddress, pin uint32 regAddress, pout uint8 *avd
 AvRet AvHalI2cWrite(pin uint32 devAddress, pin uint32 regAddress, pin uint8 *avdata, pin uint16 count)
 {
     AvRet ret = AvOk;
-    ret = AvI2cWrite(devAddress, regAddress, avdata, count);
+    ret = AvHalCacheWrite(devAddress, regAddress, avdata, count);
     return ret;
 }
 
@@ -75,6 +232,23 @@ AvRet AvHalGetMilliSecond(pout uint32 *ms)
     return ret;
 }
 
+/**
+ * @brief  abstract timer function to give up the cpu for some milliseconds
+ * @return AvOk if slept, AvNotSupport if the bsp can not sleep
+ * @note   callers polling hardware fall back to busy polling without it
+ */
+AvRet AvHalSleepMilliSecond(pin uint32 ms)
+{
+    AvRet ret = AvNotSupport;
+#ifdef COMPILER_C51_MODE
+    ret = AvSleepMilliSecond(ms);
+#else
+    if(AvSleepMilliSecond != NULL)
+        ret = AvSleepMilliSecond(ms);
+#endif
+    return ret;
+}
+
 /**
  * @brief  abstract key function to read current key value
  * @return AvOk if success
@@ -131,7 +305,7 @@ AvRet AvHalI2cRdMultiField(pin uint32 devAddress, pin uint32 regAddress, pin uin
 {
     AvRet ret = AvOk;
 
-    ret = AvI2cRead(devAddress, regAddress, avdata, number);
+    ret = AvHalCacheRead(devAddress, regAddress, avdata, number);
 
     return ret;
 }
@@ -148,7 +322,7 @@ AvRet AvHalI2cWrMultiField(pin uint32 devAddress, pin uint32 regAddress, pin uin
 {
     AvRet ret = AvOk;
 
-    ret = AvI2cWrite(devAddress, regAddress, avdata, number);
+    ret = AvHalCacheWrite(devAddress, regAddress, avdata, number);
 
     return ret;
 }
@@ -169,7 +343,7 @@ AvRet AvHalI2cWrMultiField(pin uint32 devAddress, pin uint32 regAddress, pin uin
 AvRet AvHalI2cReadField8(pin uint32 devAddress, pin uint32 regAddress, pin uint8 mask, pin uint8 bitPos, pout uint8 *avdata)
 {
     AvRet ret = AvOk;
-    ret = AvI2cRead(devAddress, regAddress, avdata, 1);
+    ret = AvHalCacheRead(devAddress, regAddress, avdata, 1);
     *avdata = (*avdata & mask) >> bitPos;
     return ret;
 }
@@ -194,10 +368,10 @@ AvRet AvHalI2cWriteField8(pin uint32 devAddress, pin uint32 regAddress, pin uint
     uint8 val = fieldVal;
     if(mask != 0xff)
     {
-        AvI2cRead(devAddress, regAddress, &val, 1);
+        AvHalCacheRead(devAddress, regAddress, &val, 1);
         val = (val & ~mask) | ((fieldVal << bitPos) & mask);
     }
-    ret = AvI2cWrite(devAddress, regAddress, &val, 1);
+    ret = AvHalCacheWrite(devAddress, regAddress, &val, 1);
     return ret;
 }
 
@@ -227,7 +401,7 @@ AvRet AvHalI2cReadField32(pin uint32 devAddress, pin uint32 regAddress, pin uint
     uint8 i, j, bytes[5];
     *avdata = 0;
 
-    ret = AvI2cRead(devAddress, regAddress, bytes, fldSpan);
+    ret = AvHalCacheRead(devAddress, regAddress, bytes, fldSpan);
 
     if (endian == AvBigEndian)
     {
@@ -284,7 +458,7 @@ AvRet AvHalI2cWriteField32 (pin uint32 devAddress, pin uint32 regAddress, pin ui
     AvRet ret = AvOk;
     uint8 i, bytes[5];
 
-    ret = AvI2cRead(devAddress, regAddress, bytes, fldSpan);
+    ret = AvHalCacheRead(devAddress, regAddress, bytes, fldSpan);
 
     if (endian == AvBigEndian)
     {
@@ -296,7 +470,7 @@ AvRet AvHalI2cWriteField32 (pin uint32 devAddress, pin uint32 regAddress, pin ui
         }
         bytes[fldSpan-1] = (bytes[fldSpan-1] & ~lsbMask) |
                        (uint8) ((avdata << lsbPos) & lsbMask);
-        ret = AvI2cWrite(devAddress, regAddress, bytes, fldSpan);
+        ret = AvHalCacheWrite(devAddress, regAddress, bytes, fldSpan);
     }
     else
     {
@@ -308,7 +482,7 @@ AvRet AvHalI2cWriteField32 (pin uint32 devAddress, pin uint32 regAddress, pin ui
         }
         bytes[fldSpan-1] = (bytes[fldSpan-1] & ~msbMask) |
                        ((avdata >> (8 * (fldSpan - 1) - lsbPos)) & msbMask);
-        ret = AvI2cWrite(devAddress, regAddress, bytes, fldSpan);
+        ret = AvHalCacheWrite(devAddress, regAddress, bytes, fldSpan);
     }
     return ret;
 }
@@ -18,11 +18,12 @@ typedef struct
 }AvI2CFieldInfo;
 
 /* hardware access functions */
-typedef AvRet (*AvFpI2cRead)(uint32, uint32, uint8 *, uint16);
-typedef AvRet (*AvFpI2cWrite)(uint32, uint32, uint8 *, uint16);
+typedef AvRet (*AvFpI2cRead)(void *, uint32, uint32, uint8 *, uint16);
+typedef AvRet (*AvFpI2cWrite)(void *, uint32, uint32, uint8 *, uint16);
 typedef AvRet (*AvFpUartSendByte)(uint8 *, uint16);
 typedef AvRet (*AvFpUartGetByte)(uint8 *);
 typedef AvRet (*AvFpGetMilliSecond)(uint32 *);
+typedef AvRet (*AvFpSleepMilliSecond)(uint32);
 typedef AvRet (*AvFpGetKey)(uint8 *);
 typedef AvRet (*AvFpGetIrda)(uint8 *);
 #ifdef COMPILER_C51_MODE
@@ -32,14 +33,19 @@ typedef AvRet (*AvFpGetIrda)(uint8 *);
 #define AvUartTxByte      BspUartSendByte
 #define AvUartRxByte      BspUartGetByte
 #define AvGetMilliSecond  BspGetMilliSecond
+#define AvSleepMilliSecond BspSleepMilliSecond
 #define AvGetKey          BspGetKey
 #define AvIrdaRxByte      BspIrdaGetByte
 #else
-#define AvI2cRead         AvHookI2cRead
-#define AvI2cWrite        AvHookI2cWrite
+/* the bus field of device address selects the bsp context of the device */
+#define AvI2cRead(dev, reg, data, count)  \
+    AvHookI2cRead(AvHookI2cContext[AvGetI2cBusAddress((dev))], (dev), (reg), (data), (count))
+#define AvI2cWrite(dev, reg, data, count) \
+    AvHookI2cWrite(AvHookI2cContext[AvGetI2cBusAddress((dev))], (dev), (reg), (data), (count))
 #define AvUartTxByte      AvHookUartTxByte
 #define AvUartRxByte      AvHookUartRxByte
 #define AvGetMilliSecond  AvHookGetMilliSecond
+#define AvSleepMilliSecond AvHookSleepMilliSecond
 #define AvGetKey          AvHookGetKey
 #define AvIrdaRxByte      AvHookGetIrda
 #endif
@@ -53,6 +59,7 @@ AvRet AvHalI2cWrite(pin uint32 devAddress, pin uint32 regAddress, pin uint8 *avd
 AvRet AvHalUartSendByte(pin uint8 *avdata, uint16 avsize);
 AvRet AvHalUartGetByte(pout uint8 *avdata);
 AvRet AvHalGetMilliSecond(pout uint32 *ms);
+AvRet AvHalSleepMilliSecond(pin uint32 ms);
 AvRet AvHalGetKey(uint8 *avdata);
 AvRet AvHalGetIrda(pout uint8 *avdata);
 AvRet AvHalGetElapsedMilliSecond(pin uint32 *oldTime, pout uint32 *elapsedTime);
@@ -69,6 +76,13 @@ AvRet AvHalI2cWriteField32(pin uint32 devAddress, pin uint32 regAddress, pin uin
 AvRet AvHalI2cWriteFragField32(pin uint32 devAddress, pin uint32 *addrTable, pin uint8 msbMask, pin uint8 lsbMask, pin uint8 lsbPos, pin uint8 endian, pin uint8 fldSpan, pin uint32 avdata);
 AvRet AvHalI2cReadRandField32(pin uint32 devAddress, pin AvI2CFieldInfo *fldInfo, pin uint8 fldSpan, pout uint32 *avdata);
 AvRet AvHalI2cWriteRandField32(pin uint32 devAddress, pin AvI2CFieldInfo *fldInfo, pin uint8 fldSpan, pin uint32 avdata);
+#if AvEnableI2cSnapshot
+AvRet AvHalI2cSnapshot(pin uint32 devAddress, pin uint8 reg, pin uint8 count);
+AvRet AvHalI2cSnapshotDrop(pin uint32 devAddress);
+#else
+#define AvHalI2cSnapshot(...)
+#define AvHalI2cSnapshotDrop(...)
+#endif
 
 uint16 LookupValue8 (uchar *Table, uchar Value, uchar EndVal, uchar Step);
 uint16 AvMemcpy(void *dst, void *src, uint32 count);
@@ -7,15 +7,14 @@
 
 #include "uapi.h"
 
-/* firmware static buffer */
-static uint8 AvGlobalStaticBuffer[AvGlobalStaticBufferSize];
-
 /* hal functions variables */
 AvFpI2cRead        AvHookI2cRead;
 AvFpI2cWrite       AvHookI2cWrite;
+void              *AvHookI2cContext[AvMaxDeviceNumber];
 AvFpUartSendByte   AvHookUartTxByte;
 AvFpUartGetByte    AvHookUartRxByte;
 AvFpGetMilliSecond AvHookGetMilliSecond;
+AvFpSleepMilliSecond AvHookSleepMilliSecond;
 AvFpGetKey         AvHookGetKey;
 AvFpGetIrda        AvHookGetIrda;
 /**
@@ -30,6 +29,7 @@ uapi AvRet AvUapiInit()
     AvHookUartTxByte = NULL;
     AvHookUartRxByte = NULL;
     AvHookGetMilliSecond = NULL;
+    AvHookSleepMilliSecond = NULL;
     AvHookGetKey = NULL;
     AvHookGetIrda = NULL;
     return AvOk;
@@ -56,6 +56,17 @@ uapi AvRet AvUapiHookBspFunctions(pin AvFpI2cRead i2cRd, pin AvFpI2cWrite i2cWr,
     return ret;
 }
 
+/**
+ * @brief  hookup user's sleep function, optional
+ * @return AvOk - success
+ * @note   without it, hardware waits poll the bus until they time out
+ */
+uapi AvRet AvUapiHookBspSleep(pin AvFpSleepMilliSecond sleepMs)
+{
+    AvHookSleepMilliSecond = sleepMs;
+    return AvOk;
+}
+
 /**
  * @brief  output debug message
  * @return AvOk - success
@@ -128,26 +139,50 @@ uapi AvRet AvUapiUartInput(pin schar *stringToFormat, ...)
 }
 
 /**
- * @brief  allocate memory from global static buffer
+ * @brief  hookup the bsp context handed to the i2c functions of a device
+ * @return AvOk - success
+ */
+uapi AvRet AvUapiHookDeviceContext(pin AvDevice *device)
+{
+    if(device->index >= AvMaxDeviceNumber)
+        return AvInvalidParameter;
+    AvHookI2cContext[device->index] = device->context;
+    return AvOk;
+}
+
+/**
+ * @brief  drop the bsp context of a device which goes away
+ * @return AvOk - success
+ */
+uapi AvRet AvUapiUnhookDeviceContext(pin AvDevice *device)
+{
+    if(device->index >= AvMaxDeviceNumber)
+        return AvInvalidParameter;
+    AvHookI2cContext[device->index] = NULL;
+    return AvOk;
+}
+
+/**
+ * @brief  allocate memory from the static buffer of a device
  * @param  bytes memory size in bytes
  * @return AvOk - success
  */
-uapi AvRet AvUapiAllocateMemory(pin uint32 bytes, pout uint64 *bufferAddress)
+uapi AvRet AvUapiAllocateMemory(pin AvDevice *device, pin uint32 bytes, pout uint64 *bufferAddress)
 {
     AvRet ret = AvOk;
-    static uint32 currentPoint = 0;
     uint32 wordbytes = bytes & 0xfffffffc;
 
-    if ((currentPoint + bytes) < AvGlobalStaticBufferSize)
+    if ((device->buffer != NULL) &&
+        ((device->bufferUsed + bytes) < AvGlobalStaticBufferSize))
     {
-        *bufferAddress = (uint64)(&AvGlobalStaticBuffer[currentPoint]);
+        *bufferAddress = (uint64)(&device->buffer[device->bufferUsed]);
         if(bytes != wordbytes)
             bytes = wordbytes + 8;
-        currentPoint = currentPoint + bytes;
+        device->bufferUsed = device->bufferUsed + bytes;
     }
     else
     {
-        AvUapiOutputDebugMessage("ERROR: global static buffer exhausted.");
+        AvUapiOutputDebugMessage("ERROR: device static buffer exhausted.");
         ret = AvNotAvailable;
     }
     return ret;
@@ -30,9 +30,11 @@
 
 extern  AvFpI2cRead        AvHookI2cRead;
 extern  AvFpI2cWrite       AvHookI2cWrite;
+extern  void              *AvHookI2cContext[AvMaxDeviceNumber];
 extern  AvFpUartSendByte   AvHookUartTxByte;
 extern  AvFpUartGetByte    AvHookUartRxByte;
 extern  AvFpGetMilliSecond AvHookGetMilliSecond;
+extern  AvFpSleepMilliSecond AvHookSleepMilliSecond;
 extern  AvFpGetKey         AvHookGetKey;
 extern  AvFpGetIrda        AvHookGetIrda;
 /* Video Interrupt */
@@ -95,6 +97,7 @@ extern "C" {
 
 uapi AvRet AvUapiInit(void);
 uapi AvRet AvUapiHookBspFunctions(pin AvFpI2cRead i2cRd, pin AvFpI2cWrite i2cWr, pin AvFpUartSendByte uartTxB, pin AvFpUartGetByte uartRxB, pin AvFpGetMilliSecond getMs, pin AvFpGetKey getKey,pin AvFpGetIrda getIrda);
+uapi AvRet AvUapiHookBspSleep(pin AvFpSleepMilliSecond sleepMs);
 uapi AvRet AvUapiOuputDbgMsg(pin schar *FormattedString, ...); /* do not call this api, call macro "AvUapiOutputDebugMessage()" */
 
 #if  AvEnableDebugMessage
@@ -110,12 +113,21 @@ uapi AvRet AvUapiOuputDbgMsg(pin schar *FormattedString, ...); /* do not call th
 #define AvUapiOutputDebugFsm(...)
 #endif
 
-uapi AvRet AvUapiAllocateMemory(pin uint32 bytes, pout uint64 *bufferAddress);
+uapi AvRet AvUapiAllocateMemory(pin AvDevice *device, pin uint32 bytes, pout uint64 *bufferAddress);
+uapi AvRet AvUapiHookDeviceContext(pin AvDevice *device);
+uapi AvRet AvUapiUnhookDeviceContext(pin AvDevice *device);
 
 uapi AvRet AvUapiConnectPort(pin AvPort *FromPort, pin AvPort *ToPort, AvConnectType type);
 uapi AvRet AvUapiDisconnectPort(pin AvPort *Port);
 
 uapi AvRet AvUapiInitDevice(pio AvDevice *device);
+uapi AvRet AvUapiResumeDevice(pio AvDevice *device);
+uapi AvRet AvUapiRestoreDevice(pio AvDevice *device);
+uapi AvRet AvUapiRestorePort(pio AvPort *port);
+uapi AvRet AvUapiReplayDevice(pio AvDevice *device);
+uapi uint8 AvUapiRegisterVolatile(pin AvDevice *device, pin uint16 regAddress);
+uapi uint8 AvUapiRegisterPrecious(pin AvDevice *device, pin uint16 regAddress);
+uapi AvRet AvUapiSnapshotPort(pio AvPort *port);
 uapi AvRet AvUapiResetPort(pio AvPort *port);
 uapi AvRet AvUapiEnablePort(pio AvPort *port);
 
@@ -166,6 +178,7 @@ uapi AvRet AvUapiTxSetAudNValue(pio AvPort *port);
 uapi AvRet AvUapiRxGetPacketType(pio AvPort *port);
 uapi AvRet AvUapiTxReadBksv(pio AvPort *port, uint8 *Value, uint8 Count);
 uapi AvRet AvUapiRxAddBksv(pio AvPort *port, uint8 *Value, uint8 Position);
+uapi AvRet AvUapiRxSetKsvList(pio AvPort *port, uint8 *List, uint8 Count);
 uapi AvRet AvUapiTxGetBksvTotal(pio AvPort *port, uint8 *Value);
 uapi AvRet AvUapiTxEncryptSink(pin AvPort *port);
 uapi AvRet AvUapiTxDecryptSink(pin AvPort *port);
@@ -184,6 +197,11 @@ uapi AvRet AvUapiCecRxGetStatus(pin AvPort *port);
 uapi AvRet AvUapiCecTxGetStatus(pin AvPort *port);
 uapi AvRet AvUapiTxCecSetPhysicalAddr(AvPort *port);
 uapi AvRet AvUapiTxCecSetLogicalAddr(AvPort *port);
+uapi AvRet AvUapiCecEnable(pin AvPort *port, uint8 Enable);
+uapi AvRet AvUapiCecSetLogAddr(pin AvPort *port, uint8 Slot, uint8 LogAddr);
+uapi AvRet AvUapiCecTransmit(pin AvPort *port, uint8 *Msg, uint8 Len, uint8 Retry);
+uapi AvRet AvUapiCecGetTxStatus(pin AvPort *port, pout uint8 *Status, pout uint8 *NackCount, pout uint8 *LowDriveCount);
+uapi AvRet AvUapiCecReceive(pin AvPort *port, pout uint8 *Msg, pout uint8 *Len);
 uapi AvRet AvUapiRxReadEdid(pio AvPort *port, uint8 *Value, uint16 Count);
 uapi AvRet AvUapiRxWriteEdid(pio AvPort *port, uint8 *Value, uint16 Count);
 uapi AvRet AvUapiRxSetSpa(pio AvPort *port, uint8 SpaLocation, uint8 *SpaValue);
@@ -207,6 +225,8 @@ uapi AvRet AvUapiRxVideoManage(pin AvPort *port, VideoInterrupt* Intpt);
 uapi AvRet AvUapiRxAudioManage(pin AvPort *port, AudioInterrupt* Intpt);
 uapi AvRet AvUapiRxReadStdi(pin AvPort *port);
 uapi AvRet AvUapiRxReadInfo(pin AvPort *port);
+uapi AvRet AvUapiGetInterrupt(pin AvPort *port, pout uint32 *IntEvents);
+uapi AvRet AvUapiEnableInterrupt(pin AvPort *port, uint32 IntEvents, uint8 Enable);
 
 #define Gsv2k11AvUapiTxClearRxidReady           AvUapiTxClearRxidReady
 #define Gsv2k11AvUapiTxDecryptSink              AvUapiTxDecryptSink
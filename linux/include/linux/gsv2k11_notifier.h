@@ -3,6 +3,9 @@
 #define __GSV2K11_NOTIFIER_H__
 
 #include <linux/device.h>
+#include <linux/notifier.h>
+#include <linux/list.h>
+#include <linux/workqueue.h>
 
 typedef enum {
     VFMT_CEA_NULL                        = 0,
@@ -82,9 +85,55 @@ typedef enum {
     VFMT_CEA_107_3840x2160P_60HZ         = 107,
 } CEA_VIDEOFORMAT_E;
 
+/*
+ * Input timing reported with every mode change. The notifier event is the
+ * VIC (0 when the input is lost) and the data argument points to this.
+ */
+struct gsv2k11_mode {
+	struct device *dev;		/* reporting gsv2k11 */
+	u8 vic;
+	u8 interlaced;
+	u8 hpolarity;
+	u8 vpolarity;
+	u16 hactive;
+	u16 vactive;			/* per frame */
+	u16 htotal;
+	u16 vtotal;
+	u16 hsync;
+	u16 hback;
+	u16 vsync;
+	u16 vback;
+	u16 frame_rate;			/* Hz */
+	u16 tmds_freq;			/* MHz */
+	u8 colorspace;			/* AVI Y2Y1Y0 */
+};
+
+/* gsv2k11 instances a consumer can be told about */
+#define GSV2K11_MAX_INSTANCES	4
+
+/*
+ * Asynchronous consumer: nb.notifier_call runs from a workqueue with a copy
+ * of the latest mode, the gsv2k11 state machine never waits for it. Changes
+ * posted by one instance before the callback got to run are coalesced into
+ * the last one, each instance with a change pending is reported once.
+ * Only nb.notifier_call is filled in by the consumer.
+ */
+struct gsv2k11_async_nb {
+	struct notifier_block nb;
+	/* private to gsv2k11 */
+	struct list_head node;
+	struct work_struct work;
+	struct gsv2k11_mode mode[GSV2K11_MAX_INSTANCES];
+	unsigned long pending;		/* instances with a mode to deliver */
+	unsigned int posted;
+	unsigned int delivered;
+};
+
 #ifdef CONFIG_GSV2K11
 extern int gsv2k11_notifier_register(struct notifier_block *nb);
 extern int gsv2k11_notifier_unregister(struct notifier_block *nb);
+extern int gsv2k11_notifier_register_async(struct gsv2k11_async_nb *anb);
+extern int gsv2k11_notifier_unregister_async(struct gsv2k11_async_nb *anb);
 #else
 static inline int gsv2k11_notifier_register(struct notifier_block *nb)
 {
@@ -95,6 +144,16 @@ static inline int gsv2k11_notifier_unregister(struct notifier_block *nb)
 {
 	return -ENODEV;
 }
+
+static inline int gsv2k11_notifier_register_async(struct gsv2k11_async_nb *anb)
+{
+	return -ENODEV;
+}
+
+static inline int gsv2k11_notifier_unregister_async(struct gsv2k11_async_nb *anb)
+{
+	return -ENODEV;
+}
 #endif
 
 #endif